@@ -0,0 +1,447 @@
+/******************************************************************************
+bench_fft.c - host throughput and accuracy benchmark for fix_fft / fix_fftr
+
+Built once per FFT implementation by the Makefile bench target, FFT_BITS
+tells which one is linked in. For every supported m it reports
+
+	ns/fft, fft/s	time per transform, input copy excluded
+	SNR		signal to error power against a double precision DFT
+			of the very same (quantized) input, same 1/n scaling
+	SFDR		tone bin to largest other bin of the fixed-point output
+	floor		mean error power per bin relative to full scale
+
+for tones at two levels, white noise at -12dBFS and at full scale and a
+linear chirp, so the throughput versus dynamic range trade off of the int8
+and int16 variants can be read off directly.
+
+The clip rows scan tones 6dB over full scale, clipped, across the band and
+at several phases, and report the worst bin error of fix_fft and fix_fftr:
+fix_fftr() packs pairs of samples into complex points and must make room
+for them. A bin off by more than CLIP_ERR, about a wrapped butterfly, fails
+the run.
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "fix_fft.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FS		(1L << (FFT_BITS - 1))		// full scale
+#define MAX_N		N_WAVE
+#define MIN_TIME	0.02				// seconds per timing run
+#define CLIP_ERR	(FS / 8)			// largest bin error of a clipped tone
+#define CLIP_TONES	32				// most tones per size
+#define CLIP_PHASES	4
+
+#if FFT_BITS == 16 && defined(FFT_TEMPLATE)
+#define FFT_NAME	"int16t"
+#elif FFT_BITS == 16 && defined(FFT_QUARTER_WAVE)
+#define FFT_NAME	"int16qw"
+#elif FFT_BITS == 16
+#define FFT_NAME	"int16"
+#elif defined(FFT_TEMPLATE)
+#define FFT_NAME	"int8t"
+#elif defined(FFT_BLOCK_FLOAT)
+#define FFT_NAME	"int8bfp"
+#elif defined(FFT_RADIX4)
+#define FFT_NAME	"int8r4"
+#elif defined(FIX_MPY_QSQ)
+#define FFT_NAME	"int8qsq"
+#else
+#define FFT_NAME	"int8"
+#endif
+
+enum { SIG_TONE, SIG_TONE_LOW, SIG_NOISE, SIG_NOISE_FULL, SIG_CHIRP, SIGNALS };
+
+static const char *sig_name[SIGNALS] = { "tone-6", "tone-30", "noise-12", "noise+0", "chirp-6" };
+
+static fixed in[MAX_N], wr[MAX_N], wi[MAX_N];
+static double ref_r[MAX_N], ref_i[MAX_N];
+static volatile int sink;
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static fixed quantize(double x) {
+	long v = lrint(x * FS);
+	if (v > FS - 1)
+		v = FS - 1;
+	if (v < -FS)
+		v = -FS;
+	return (fixed)v;
+}
+
+// tone bin for size n, away from DC and Nyquist when possible
+static int tone_bin(int n) {
+	return (3 * n / 16) ? 3 * n / 16 : 1;
+}
+
+static void make_signal(int sig, int n) {
+	static uint32_t state = 0x2545F491;
+	double x = 0, f0 = 0.05, f1 = 0.45;
+	int i;
+
+	for (i = 0; i < n; ++i) {
+		switch (sig) {
+			case SIG_TONE:
+				x = 0.5 * sin(2 * M_PI * tone_bin(n) * i / n);
+				break;
+			case SIG_TONE_LOW:
+				x = 0.0316 * sin(2 * M_PI * tone_bin(n) * i / n);
+				break;
+			case SIG_NOISE:
+				// uniform, rms 0.25 (-12 dBFS)
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				x = 0.433 * ((double)state / 2147483648.0 - 1.0);
+				break;
+			case SIG_NOISE_FULL:
+				// uniform over the whole range, peaks clipped
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				x = (double)state / 2147483648.0 - 1.0;
+				break;
+			case SIG_CHIRP:
+				x = 0.5 * sin(2 * M_PI * (f0 * i + (f1 - f0) * i * i / (2.0 * n)));
+				break;
+		}
+		in[i] = quantize(x);
+	}
+}
+
+// reference DFT of the quantized real input, scaled by 1/n like fix_fft
+static void reference(int n) {
+	int i, k;
+	for (k = 0; k < n; ++k) {
+		double sr = 0, si = 0;
+		for (i = 0; i < n; ++i) {
+			double a = -2 * M_PI * (double)((long)i * k % n) / n;
+			sr += in[i] * cos(a);
+			si += in[i] * sin(a);
+		}
+		ref_r[k] = sr / n;
+		ref_i[k] = si / n;
+	}
+}
+
+static double db(double x) {
+	return x > 0 ? 10 * log10(x) : -99.9;
+}
+
+/*
+  compare bins 0..nb-1 of out_r/out_i, shifted right by the block
+  exponent e, against the reference; tone and mirror are excluded
+  from the spurs, tone < 0 means no SFDR for this signal
+*/
+static void accuracy(const fixed out_r[], const fixed out_i[], int nb, int e,
+		int tone, int mirror, double *snr, double *sfdr, double *floor_db) {
+	double sig = 0, err = 0, spur = 0, peak = 0, p;
+	int k;
+
+	for (k = 0; k < nb; ++k) {
+		double xr = ldexp(out_r[k], -e), xi = ldexp(out_i[k], -e);
+		double er = xr - ref_r[k], ei = xi - ref_i[k];
+		sig += ref_r[k] * ref_r[k] + ref_i[k] * ref_i[k];
+		err += er * er + ei * ei;
+		p = xr * xr + xi * xi;
+		if (k == tone || k == mirror) {
+			if (p > peak)
+				peak = p;
+		} else if (p > spur) {
+			spur = p;
+		}
+	}
+	// double precision round off is not an error of the transform
+	if (err < 1e-12 * nb)
+		err = 0;
+	*snr = err > 0 ? db(sig / err) : 99.9;
+	*floor_db = db(err / nb / ((double)FS * FS));
+	if (tone < 0)
+		*sfdr = NAN;
+	else
+		*sfdr = spur > 0 ? db(peak / spur) : 99.9;
+}
+
+// largest bin error of out_r/out_i, shifted by e, against the reference
+static double max_error(const fixed out_r[], const fixed out_i[], int nb, int e) {
+	double err = 0, d;
+	int k;
+
+	for (k = 0; k < nb; ++k) {
+		d = hypot(ldexp(out_r[k], -e) - ref_r[k], ldexp(out_i[k], -e) - ref_i[k]);
+		if (d > err)
+			err = d;
+	}
+	return err;
+}
+
+/*
+  worst bin error over clipped full scale tones of size 2^m, of
+  fix_fftr when real, else of fix_fft with zero imaginary parts
+*/
+static double clip_error(int m, int real) {
+	fixed im[MAX_N];
+	double err = 0, d;
+	int n = 1 << m, step = n / 2 > CLIP_TONES ? n / 2 / CLIP_TONES : 1, b, p, i, e;
+
+	for (b = 0; b < n / 2; b += step) {
+		for (p = 0; p < CLIP_PHASES; ++p) {
+			for (i = 0; i < n; ++i)
+				in[i] = quantize(2.0 * sin(2 * M_PI * (b + 0.3) * i / n + p * 2 * M_PI / CLIP_PHASES));
+			reference(n);
+			memcpy(wr, in, n * sizeof(fixed));
+			if (real) {
+				e = fix_fftr(wr, m, 0);
+				memcpy(im, wr + n / 2, n / 2 * sizeof(fixed));
+				im[0] = 0;
+			} else {
+				memset(im, 0, n * sizeof(fixed));
+				e = fix_fft(wr, im, m, 0);
+			}
+			d = max_error(wr, im, n / 2, e);
+			if (d > err)
+				err = d;
+		}
+	}
+	return err;
+}
+
+static void print_row(const char *func, int m, int n, double ns, int sig,
+		double snr, double sfdr, double floor_db) {
+	printf("%-7s %-8s %2d %5d %10.1f %10.0f  %-9s %6.1f ", FFT_NAME, func, m, n,
+		ns, 1e9 / ns, sig_name[sig], snr);
+	if (isnan(sfdr))
+		printf("%7s ", "-");
+	else
+		printf("%7.1f ", sfdr);
+	printf("%9.1f\n", floor_db);
+}
+
+// complex transform of n = 2^m real samples, the way led_fft.c calls it
+static double time_fft(int m) {
+	int n = 1 << m;
+	long it, iters = 0;
+	double t0, t, copy;
+
+	for (it = 1; ; it <<= 1) {
+		int j;
+		t0 = now();
+		for (j = 0; j < it; ++j) {
+			memcpy(wr, in, n * sizeof(fixed));
+			memset(wi, 0, n * sizeof(fixed));
+			sink += fix_fft(wr, wi, m, 0);
+		}
+		t = now() - t0;
+		iters = it;
+		if (t > MIN_TIME)
+			break;
+	}
+	t0 = now();
+	for (it = 0; it < iters; ++it) {
+		memcpy(wr, in, n * sizeof(fixed));
+		memset(wi, 0, n * sizeof(fixed));
+		sink += wr[it & (n - 1)];
+	}
+	copy = now() - t0;
+	return (t - copy) * 1e9 / iters;
+}
+
+// real transform of n = 2^m samples
+static double time_fftr(int m) {
+	int n = 1 << m;
+	long it, iters = 0;
+	double t0, t, copy;
+
+	for (it = 1; ; it <<= 1) {
+		int j;
+		t0 = now();
+		for (j = 0; j < it; ++j) {
+			memcpy(wr, in, n * sizeof(fixed));
+			sink += fix_fftr(wr, m, 0);
+		}
+		t = now() - t0;
+		iters = it;
+		if (t > MIN_TIME)
+			break;
+	}
+	t0 = now();
+	for (it = 0; it < iters; ++it) {
+		memcpy(wr, in, n * sizeof(fixed));
+		sink += wr[it & (n - 1)];
+	}
+	copy = now() - t0;
+	return (t - copy) * 1e9 / iters;
+}
+
+// inverse real transform of the spectrum in wi[]
+static double time_ifftr(int m) {
+	int n = 1 << m;
+	long it, iters = 0;
+	double t0, t, copy;
+
+	for (it = 1; ; it <<= 1) {
+		int j;
+		t0 = now();
+		for (j = 0; j < it; ++j) {
+			memcpy(wr, wi, n * sizeof(fixed));
+			sink += fix_fftr(wr, m, 1);
+		}
+		t = now() - t0;
+		iters = it;
+		if (t > MIN_TIME)
+			break;
+	}
+	t0 = now();
+	for (it = 0; it < iters; ++it) {
+		memcpy(wr, wi, n * sizeof(fixed));
+		sink += wr[it & (n - 1)];
+	}
+	copy = now() - t0;
+	return (t - copy) * 1e9 / iters;
+}
+
+// FIX_MPY as specified: product, shift one less, round with the last bit out
+static fixed mpy_ref(fixed a, fixed b) {
+	long c = ((long)a * b) >> (FFT_BITS - 2);
+	return (fixed)((c >> 1) + (c & 1));
+}
+
+/*
+  FIX_MPY microbenchmark: time per radix-2 butterfly (4 FIX_MPY
+  and 6 adds) and a check of FIX_MPY against mpy_ref, over all
+  operand pairs for int8
+*/
+static void bench_mpy(void) {
+	long it, iters = 0, bad = 0, a, b, step = FFT_BITS == 8 ? 1 : 257;
+	double t0, t = 0;
+	int i;
+	fixed xr[64], xi[64], w_r = quantize(0.7071), w_i = quantize(-0.7071);
+
+	for (a = -FS; a < FS; a += step)
+		for (b = -FS; b < FS; b += step)
+			if (FIX_MPY(a, b) != mpy_ref(a, b))
+				++bad;
+
+	for (i = 0; i < 64; ++i) {
+		xr[i] = quantize(0.9 * sin(i * 0.37));
+		xi[i] = quantize(0.9 * cos(i * 0.91));
+	}
+	for (it = 1; ; it <<= 1) {
+		t0 = now();
+		for (iters = 0; iters < it; ++iters) {
+			for (i = 0; i < 64; i += 2) {
+				fixed tr = FIX_MPY(w_r, xr[i+1]) - FIX_MPY(w_i, xi[i+1]);
+				fixed ti = FIX_MPY(w_r, xi[i+1]) + FIX_MPY(w_i, xr[i+1]);
+				xr[i+1] = xr[i] - tr;
+				xi[i+1] = xi[i] - ti;
+				xr[i] = xr[i] + tr;
+				xi[i] = xi[i] + ti;
+			}
+			sink += xr[iters & 63];
+		}
+		t = now() - t0;
+		if (t > MIN_TIME)
+			break;
+	}
+	printf("%-7s %-8s %10.2f ns/butterfly, FIX_MPY %s\n", FFT_NAME, "FIX_MPY",
+		t * 1e9 / (iters * 32.0), bad ? "NOT bit-exact" : "bit-exact");
+}
+
+int main(void) {
+	int m, n, sig, tone, e, real, failed = 0;
+	double ns, snr, sfdr, floor_db, err;
+
+	printf("%-7s %-8s %2s %5s %10s %10s  %-9s %6s %7s %9s\n", "width", "func",
+		"m", "n", "ns/fft", "fft/s", "signal", "SNR dB", "SFDR dB", "floor dBFS");
+
+	for (m = 1; m <= LOG2_N_WAVE; ++m) {
+		n = 1 << m;
+		make_signal(SIG_TONE, n);
+		ns = time_fft(m);
+		for (sig = 0; sig < SIGNALS; ++sig) {
+			make_signal(sig, n);
+			reference(n);
+			memcpy(wr, in, n * sizeof(fixed));
+			memset(wi, 0, n * sizeof(fixed));
+			e = fix_fft(wr, wi, m, 0);
+			tone = sig <= SIG_TONE_LOW ? tone_bin(n) : -1;
+			accuracy(wr, wi, n, e, tone, n - tone, &snr, &sfdr, &floor_db);
+			print_row("fix_fft", m, n, ns, sig, snr, sfdr, floor_db);
+		}
+	}
+
+	/*
+	  fix_fftr: bins 0..n/2-1, real parts in f[0..n/2-1],
+	  imaginary parts in f[n/2..n-1]
+	*/
+	for (m = 1; m <= LOG2_N_WAVE; ++m) {
+		n = 1 << m;
+		make_signal(SIG_TONE, n);
+		ns = time_fftr(m);
+		for (sig = 0; sig < SIGNALS; ++sig) {
+			fixed im[MAX_N / 2];
+			make_signal(sig, n);
+			reference(n);
+			memcpy(wr, in, n * sizeof(fixed));
+			e = fix_fftr(wr, m, 0);
+			memcpy(im, wr + n / 2, n / 2 * sizeof(fixed));
+			// im[0] of a real spectrum is 0, the slot carries bin n/2
+			im[0] = 0;
+			tone = sig <= SIG_TONE_LOW && tone_bin(n) < n / 2 ? tone_bin(n) : -1;
+			accuracy(wr, im, n / 2, e, tone, -1, &snr, &sfdr, &floor_db);
+			print_row("fix_fftr", m, n, ns, sig, snr, sfdr, floor_db);
+		}
+	}
+
+	// fix_fftr inverse of the forward output against the input samples
+	for (m = 1; m <= LOG2_N_WAVE; ++m) {
+		n = 1 << m;
+		for (sig = 0; sig < SIGNALS; ++sig) {
+			double sig_p = 0, err_p = 0, d;
+			int i, scale;
+			make_signal(sig, n);
+			memcpy(wi, in, n * sizeof(fixed));
+			e = fix_fftr(wi, m, 0);
+			ns = time_ifftr(m);
+			memcpy(wr, wi, n * sizeof(fixed));
+			// the left shift of the inverse less the block exponent
+			scale = fix_fftr(wr, m, 1) - e;
+			for (i = 0; i < n; ++i) {
+				d = ldexp(wr[i], scale) - in[i];
+				sig_p += (double)in[i] * in[i];
+				err_p += d * d;
+			}
+			snr = err_p > 0 ? db(sig_p / err_p) : 99.9;
+			print_row("ifftr", m, n, ns, sig, snr, NAN, db(err_p / n / ((double)FS * FS)));
+		}
+	}
+
+	// headroom for full scale input
+	for (real = 0; real <= 1; ++real) {
+		for (m = 1; m <= LOG2_N_WAVE; ++m) {
+			n = 1 << m;
+			err = clip_error(m, real);
+			printf("%-7s %-8s %2d %5d  clip, worst bin error %.1f of %ld, %s\n", FFT_NAME,
+				real ? "fix_fftr" : "fix_fft", m, n, err, (long)CLIP_ERR,
+				err > CLIP_ERR ? "FAIL" : "ok");
+			if (err > CLIP_ERR)
+				failed = 1;
+		}
+	}
+
+	bench_mpy();
+
+	return failed;
+}
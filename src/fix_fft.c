@@ -10,6 +10,15 @@
   sine/cosine wave (i.e. amplitude = 32767) to two -6dB freq
   coefficients. The return value is always 0.
 
+  Built with -DFFT_BLOCK_FLOAT the forward FFT scales like the
+  inverse instead: a pass is halved only if its input peak could
+  overflow (block floating point), so small signals keep their
+  low bits, and halved twice where a single halving could still
+  overflow on complex data. The return value is then the number
+  of halvings skipped less the extra ones, i.e. the number of
+  bits RIGHT by which the output must be shifted to get the
+  fixed scaling result; negative for input near full scale.
+
   For the inverse FFT (freq -> time), fixed scaling cannot be
   done, as two 0dB coefficients would sum to a peak amplitude
   of 64K, overflowing the 32k range of the fixed-point integers.
@@ -30,62 +39,109 @@
   Chris Chung changed data_type for msp430 use June 2013
 */
 
-#define N_WAVE      256    /* full length of Sinewave[] */
-#define LOG2_N_WAVE 8      /* log2(N_WAVE) */
-
+#define FFT_BITS 8
 
 #include <stdint.h>
 #include <stdlib.h>
+#include "fix_fft.h"
+#include "fix_fft_tables.h"
 
 /*
-  Since we only use 3/4 of N_WAVE, we define only
-  this many samples, in order to conserve data space.
-*/
-
-
-
-const int8_t Sinewave[N_WAVE-N_WAVE/4] = {
-0, 3, 6, 9, 12, 15, 18, 21,
-24, 28, 31, 34, 37, 40, 43, 46,
-48, 51, 54, 57, 60, 63, 65, 68,
-71, 73, 76, 78, 81, 83, 85, 88,
-90, 92, 94, 96, 98, 100, 102, 104,
-106, 108, 109, 111, 112, 114, 115, 117,
-118, 119, 120, 121, 122, 123, 124, 124,
-125, 126, 126, 127, 127, 127, 127, 127,
-
-127, 127, 127, 127, 127, 127, 126, 126,
-125, 124, 124, 123, 122, 121, 120, 119,
-118, 117, 115, 114, 112, 111, 109, 108,
-106, 104, 102, 100, 98, 96, 94, 92,
-90, 88, 85, 83, 81, 78, 76, 73,
-71, 68, 65, 63, 60, 57, 54, 51,
-48, 46, 43, 40, 37, 34, 31, 28,
-24, 21, 18, 15, 12, 9, 6, 3,
-
-0, -3, -6, -9, -12, -15, -18, -21,
--24, -28, -31, -34, -37, -40, -43, -46,
--48, -51, -54, -57, -60, -63, -65, -68,
--71, -73, -76, -78, -81, -83, -85, -88,
--90, -92, -94, -96, -98, -100, -102, -104,
--106, -108, -109, -111, -112, -114, -115, -117,
--118, -119, -120, -121, -122, -123, -124, -124,
--125, -126, -126, -127, -127, -127, -127, -127,
-
-/*-127, -127, -127, -127, -127, -127, -126, -126,
--125, -124, -124, -123, -122, -121, -120, -119,
--118, -117, -115, -114, -112, -111, -109, -108,
--106, -104, -102, -100, -98, -96, -94, -92,
--90, -88, -85, -83, -81, -78, -76, -73,
--71, -68, -65, -63, -60, -57, -54, -51,
--48, -46, -43, -40, -37, -34, -31, -28,
--24, -21, -18, -15, -12, -9, -6, -3, */
-};
+  Largest |re| or |im| a butterfly pass takes without halving:
+  a radix-2 butterfly grows its input up to 1+sqrt(2) times,
+  a radix-4 one up to 1+3*sqrt(2) times, and the result must
+  stay within int8. Each bit of halving doubles the peak a pass
+  takes, up to 2 bits for radix-2 and 3 for radix-4 cover any
+  int8 input.
+*/
+#define PEAK_R2 52
+#define PEAK_R4 24
 
+/*
+  Largest |sample| fix_fftr() packs in pairs into the complex
+  points of the fixed scaling passes: these keep the modulus of
+  a point within that of their input, which must stay below 128,
+  127/sqrt(2) for two full scale samples.
+*/
+#define PEAK_PACK 89
 
+/*
+  Since we only use 3/4 of N_WAVE, Sinewave[] of fix_fft_tables.h
+  holds only this many samples, in order to conserve data space.
+  -DFFT_QUARTER_WAVE keeps just the first quarter, SINE() then
+  folds the twiddle factors out of it by symmetry.
+*/
+#ifdef FFT_QUARTER_WAVE
+#define SINE(j) fix_sin(j)
+#else
+#define SINE(j) Sinewave[j]
+#endif
 
+/*
+  fix_sin() - sin(2*pi*j/N_WAVE) for any j, by sin(x) = -sin(x-pi)
+  and sin(x) = sin(pi-x) from the part of the wave in Sinewave[].
+*/
+int8_t fix_sin(int16_t j)
+{
+    j &= N_WAVE-1;
+#ifdef FFT_QUARTER_WAVE
+    if (j & N_WAVE/2)
+        return (j & (N_WAVE/2-1)) > N_WAVE/4 ? -Sinewave[N_WAVE-j] : -Sinewave[j-N_WAVE/2];
+    return j > N_WAVE/4 ? Sinewave[N_WAVE/2-j] : Sinewave[j];
+#else
+    if (j < N_WAVE-N_WAVE/4)
+        return Sinewave[j];
+    return -Sinewave[j-N_WAVE/2];
+#endif
+}
+
+#ifdef FIX_MPY_QSQ
+/*
+  Quarter-square multiplication, built with -DFIX_MPY_QSQ:
+
+    a*b = floor((a+b)^2/4) - floor((a-b)^2/4)
 
-#define fixed int8_t
+  is exact for integers, as a+b and a-b are both odd or both
+  even. Two lookups in flash replace the libgcc software
+  multiply on parts without a hardware multiplier, such as the
+  G2553. qsq[i] = floor(i*i/4), |a+b| <= 256, |a-b| <= 255.
+*/
+const uint16_t qsq[257] = {
+0, 0, 1, 2, 4, 6, 9, 12,
+16, 20, 25, 30, 36, 42, 49, 56,
+64, 72, 81, 90, 100, 110, 121, 132,
+144, 156, 169, 182, 196, 210, 225, 240,
+256, 272, 289, 306, 324, 342, 361, 380,
+400, 420, 441, 462, 484, 506, 529, 552,
+576, 600, 625, 650, 676, 702, 729, 756,
+784, 812, 841, 870, 900, 930, 961, 992,
+1024, 1056, 1089, 1122, 1156, 1190, 1225, 1260,
+1296, 1332, 1369, 1406, 1444, 1482, 1521, 1560,
+1600, 1640, 1681, 1722, 1764, 1806, 1849, 1892,
+1936, 1980, 2025, 2070, 2116, 2162, 2209, 2256,
+2304, 2352, 2401, 2450, 2500, 2550, 2601, 2652,
+2704, 2756, 2809, 2862, 2916, 2970, 3025, 3080,
+3136, 3192, 3249, 3306, 3364, 3422, 3481, 3540,
+3600, 3660, 3721, 3782, 3844, 3906, 3969, 4032,
+4096, 4160, 4225, 4290, 4356, 4422, 4489, 4556,
+4624, 4692, 4761, 4830, 4900, 4970, 5041, 5112,
+5184, 5256, 5329, 5402, 5476, 5550, 5625, 5700,
+5776, 5852, 5929, 6006, 6084, 6162, 6241, 6320,
+6400, 6480, 6561, 6642, 6724, 6806, 6889, 6972,
+7056, 7140, 7225, 7310, 7396, 7482, 7569, 7656,
+7744, 7832, 7921, 8010, 8100, 8190, 8281, 8372,
+8464, 8556, 8649, 8742, 8836, 8930, 9025, 9120,
+9216, 9312, 9409, 9506, 9604, 9702, 9801, 9900,
+10000, 10100, 10201, 10302, 10404, 10506, 10609, 10712,
+10816, 10920, 11025, 11130, 11236, 11342, 11449, 11556,
+11664, 11772, 11881, 11990, 12100, 12210, 12321, 12432,
+12544, 12656, 12769, 12882, 12996, 13110, 13225, 13340,
+13456, 13572, 13689, 13806, 13924, 14042, 14161, 14280,
+14400, 14520, 14641, 14762, 14884, 15006, 15129, 15252,
+15376, 15500, 15625, 15750, 15876, 16002, 16129, 16256,
+16384
+};
+#endif /* FIX_MPY_QSQ */
 
 /*
   FIX_MPY() - fixed-point16_t multiplication & scaling.
@@ -95,8 +151,19 @@ const int8_t Sinewave[N_WAVE-N_WAVE/4] = {
 */
 int8_t FIX_MPY(int8_t a, int8_t b)
 {
+#ifdef FIX_MPY_QSQ
+    int16_t s = a + b, d = a - b, c;
+
+    if (s < 0)
+        s = -s;
+    if (d < 0)
+        d = -d;
+    /* same product, same shift and rounding as below */
+    c = (int16_t)(qsq[s] - qsq[d]) >> 6;
+#else
     /* shift right one less bit (i.e. 15-1) */
     int16_t c = ((int16_t)a * (int16_t)b) >> 6;
+#endif
     /* last bit shifted out = rounding-bit */
     b = c & 0x01;
     /* last shift + rounding bit */
@@ -105,6 +172,49 @@ int8_t FIX_MPY(int8_t a, int8_t b)
     return a;
 }
 
+static int16_t fix_fft_stages(int8_t fr[], int8_t fi[], int16_t n, int16_t inverse);
+
+/*
+  fix_bitrev() - bit-reversed reorder of f[0..2**m-1], the
+  re-order step of fix_fft() on a single array. Sizes up to
+  BITREV_MAX_M walk the swap pairs of fix_fft_tables.h, larger
+  ones compute the reversed index.
+*/
+static void fix_bitrev(int8_t f[], int16_t m)
+{
+    int16_t mr, nn, l, n, i;
+    int8_t tt;
+    const bitrev_t *p, *end;
+
+    if (m <= BITREV_MAX_M) {
+        p = bitrev_pairs + 2*bitrev_start[m];
+        end = bitrev_pairs + 2*bitrev_start[m+1];
+        for (; p < end; p += 2) {
+            tt = f[p[0]];
+            f[p[0]] = f[p[1]];
+            f[p[1]] = tt;
+        }
+        return;
+    }
+
+    n = 1 << m;
+    mr = 0;
+    nn = n - 1;
+    for (i=1; i<=nn; ++i) {
+        l = n;
+        do {
+            l >>= 1;
+        } while (mr+l > nn);
+        mr = (mr & (l-1)) + l;
+
+        if (mr <= i)
+            continue;
+        tt = f[i];
+        f[i] = f[mr];
+        f[mr] = tt;
+    }
+}
+
 /*
   fix_fft() - perform forward/inverse fast Fourier transform.
   fr[n],fi[n] are real and imaginary arrays, both INPUT AND
@@ -113,8 +223,7 @@ int8_t FIX_MPY(int8_t a, int8_t b)
 */
 int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
 {
-    int16_t mr, nn, i, j, l, k, istep, n, scale, shift;
-    int8_t qr, qi, tr, ti, wr, wi;
+    int16_t n;
 
     n = 1 << m;
 
@@ -122,49 +231,208 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
     if (n > N_WAVE)
         return -1;
 
-    mr = 0;
-    nn = n - 1;
+    /* decimation in time - re-order data */
+    fix_bitrev(fr, m);
+    fix_bitrev(fi, m);
+
+    return fix_fft_stages(fr, fi, n, inverse);
+}
+
+/*
+  fix_peak() - largest |re| or |im| of n points, the variable
+  scaling test of the inverse and of -DFFT_BLOCK_FLOAT.
+*/
+static int16_t fix_peak(const int8_t fr[], const int8_t fi[], int16_t n)
+{
+    int16_t i, j, peak = 0;
+
+    for (i=0; i<n; ++i) {
+        j = fr[i];
+        if (j < 0)
+            j = -j;
+        if (j > peak)
+            peak = j;
+        j = fi[i];
+        if (j < 0)
+            j = -j;
+        if (j > peak)
+            peak = j;
+    }
+    return peak;
+}
+
+/*
+  fix_shift() - bits a pass must halve its input by so that
+  every output of its butterflies fits int8, from the input
+  peak: the least shift with peak <= limit << shift, at most
+  max. The variable scaling of the inverse and of
+  -DFFT_BLOCK_FLOAT.
+*/
+static int16_t fix_shift(int16_t peak, int16_t limit, int16_t max)
+{
+    int16_t shift = 0;
+
+    while (shift < max && peak > limit << shift)
+        ++shift;
+    return shift;
+}
+
+#ifdef FFT_RADIX4
+/*
+  fix_twiddle() - W^j = exp(-2*pi*i*j/N_WAVE) for 0 <= j <
+  3*N_WAVE/4, folded into the stored part of Sinewave[] by
+  fix_sin(); conjugate for the inverse transform.
+*/
+static void fix_twiddle(int16_t j, int16_t inverse, int8_t *wr, int8_t *wi)
+{
+    *wr =  fix_sin(j+N_WAVE/4);
+    *wi = -fix_sin(j);
+    if (inverse)
+        *wi = -*wi;
+}
+
+/*
+  fix_fft_stages() - radix-4 version, built with -DFFT_RADIX4.
+  Two radix-2 passes of spans l and 2l are merged into a single
+  pass of 4-point butterflies on x0..x3 = x[i], x[i+l], x[i+2l],
+  x[i+3l] (W = exp(-2*pi*i/4l)):
+
+    c1 = W^2m x1,  c2 = W^m x2,  c3 = W^3m x3
+    y0 = x0 + c1 + (c2 + c3)    y2 = x0 + c1 - (c2 + c3)
+    y1 = x0 - c1 - j(c2 - c3)   y3 = x0 - c1 + j(c2 - c3)
+
+  That is 12 FIX_MPY per 4 points instead of 16, none at all
+  for m = 0, and half the passes over the data. An odd log2(n)
+  starts with a multiply-free radix-2 pass of span 1. Input
+  order, in-place output and scaling are those of the radix-2
+  passes: the forward transform halves once per radix-2 pass
+  folded in, the inverse (and the forward with FFT_BLOCK_FLOAT)
+  shifts 0..3 bits as the data requires.
+*/
+static int16_t fix_fft_stages(int8_t fr[], int8_t fi[], int16_t n, int16_t inverse)
+{
+    int16_t i, i1, i2, i3, m, j, l, k, istep, scale, shift;
+    int16_t ar, ai, br, bi, sr, si, dr, di;
+    int16_t c1r, c1i, c2r, c2i, c3r, c3i;
+    int8_t w1r, w1i, w2r, w2i, w3r, w3i;
+
     scale = 0;
+    l = 1;
+    k = LOG2_N_WAVE-1;
 
-    /* decimation in time - re-order data */
-    for (m=1; m<=nn; ++m) {
-        l = n;
-        do {
-            l >>= 1;
-        } while (mr+l > nn);
-        mr = (mr & (l-1)) + l;
+    /* odd number of radix-2 passes: span 1, twiddle factor 1 */
+    for (m=0; (1 << m) < n; ++m)
+        ;
+    if (m & 1) {
+#ifdef FFT_BLOCK_FLOAT
+        shift = fix_peak(fr, fi, n) > PEAK_R2;
+        scale += inverse ? shift : !shift;
+#else
+        shift = inverse ? fix_peak(fr, fi, n) > PEAK_R2 : 1;
+        scale += inverse ? shift : 0;
+#endif
+        for (i=0; i<n; i+=2) {
+            ar = fr[i];
+            ai = fi[i];
+            br = fr[i+1];
+            bi = fi[i+1];
+            fr[i] = (ar + br) >> shift;
+            fi[i] = (ai + bi) >> shift;
+            fr[i+1] = (ar - br) >> shift;
+            fi[i+1] = (ai - bi) >> shift;
+        }
+        l = 2;
+        --k;
+    }
 
-        if (mr <= m)
-            continue;
-        tr = fr[m];
-        fr[m] = fr[mr];
-        fr[mr] = tr;
-        ti = fi[m];
-        fi[m] = fi[mr];
-        fi[mr] = ti;
+    while (l < n) {
+#ifndef FFT_BLOCK_FLOAT
+        if (!inverse) {
+            shift = 2;
+        } else
+#endif
+        {
+            shift = fix_shift(fix_peak(fr, fi, n), PEAK_R4, 3);
+            scale += inverse ? shift : 2 - shift;
+        }
+        istep = l << 2;
+        for (m=0; m<l; ++m) {
+            /* 0 <= j < N_WAVE/4, so 3j < 3*N_WAVE/4 */
+            j = m << (k-1);
+            fix_twiddle(j, inverse, &w1r, &w1i);
+            fix_twiddle(2*j, inverse, &w2r, &w2i);
+            fix_twiddle(3*j, inverse, &w3r, &w3i);
+            for (i=m; i<n; i+=istep) {
+                i1 = i + l;
+                i2 = i1 + l;
+                i3 = i2 + l;
+                if (m) {
+                    c1r = FIX_MPY(w2r,fr[i1]) - FIX_MPY(w2i,fi[i1]);
+                    c1i = FIX_MPY(w2r,fi[i1]) + FIX_MPY(w2i,fr[i1]);
+                    c2r = FIX_MPY(w1r,fr[i2]) - FIX_MPY(w1i,fi[i2]);
+                    c2i = FIX_MPY(w1r,fi[i2]) + FIX_MPY(w1i,fr[i2]);
+                    c3r = FIX_MPY(w3r,fr[i3]) - FIX_MPY(w3i,fi[i3]);
+                    c3i = FIX_MPY(w3r,fi[i3]) + FIX_MPY(w3i,fr[i3]);
+                } else {
+                    c1r = fr[i1];
+                    c1i = fi[i1];
+                    c2r = fr[i2];
+                    c2i = fi[i2];
+                    c3r = fr[i3];
+                    c3i = fi[i3];
+                }
+                ar = fr[i] + c1r;
+                ai = fi[i] + c1i;
+                br = fr[i] - c1r;
+                bi = fi[i] - c1i;
+                sr = c2r + c3r;
+                si = c2i + c3i;
+                dr = c2r - c3r;
+                di = c2i - c3i;
+                /* the inverse rotates by +j instead of -j */
+                if (inverse) {
+                    dr = -dr;
+                    di = -di;
+                }
+                fr[i]  = (ar + sr) >> shift;
+                fi[i]  = (ai + si) >> shift;
+                fr[i2] = (ar - sr) >> shift;
+                fi[i2] = (ai - si) >> shift;
+                fr[i1] = (br + di) >> shift;
+                fi[i1] = (bi - dr) >> shift;
+                fr[i3] = (br - di) >> shift;
+                fi[i3] = (bi + dr) >> shift;
+            }
+        }
+        k -= 2;
+        l = istep;
     }
+    return scale;
+}
+#else
+/*
+  fix_fft_stages() - butterfly passes of fix_fft() on n points
+  that are already in bit-reversed order.
+*/
+static int16_t fix_fft_stages(int8_t fr[], int8_t fi[], int16_t n, int16_t inverse)
+{
+    int16_t m, i, j, l, k, istep, scale, shift;
+    int8_t qr, qi, tr, ti, wr, wi;
 
+    scale = 0;
     l = 1;
     k = LOG2_N_WAVE-1;
     while (l < n) {
         if (inverse) {
             /* variable scaling, depending upon data */
-            shift = 0;
-            for (i=0; i<n; ++i) {
-                j = fr[i];
-                if (j < 0)
-                    j = -j;
-                m = fi[i];
-                if (m < 0)
-                    m = -m;
-                if (j > 16383 || m > 16383) {
-                    shift = 1;
-                    break;
-                }
-            }
-            if (shift)
-                ++scale;
+            shift = fix_shift(fix_peak(fr, fi, n), PEAK_R2, 2);
+            scale += shift;
         } else {
+#ifdef FFT_BLOCK_FLOAT
+            /* the same, counting the halvings skipped */
+            shift = fix_shift(fix_peak(fr, fi, n), PEAK_R2, 2);
+            scale += 1 - shift;
+#else
             /*
               fixed scaling, for proper normalization --
               there will be log2(n) passes, so this results
@@ -172,6 +440,7 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
               maximize arithmetic accuracy.
             */
             shift = 1;
+#endif
         }
         /*
           it may not be obvious, but the shift will be
@@ -183,26 +452,22 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
             j = m << k;
             /* 0 <= j < N_WAVE/2 */
             //wr =  pgm_read_word_near(Sinewave + j+N_WAVE/4);
-            wr =  Sinewave[j+N_WAVE/4];
+            wr =  SINE(j+N_WAVE/4);
 
             //wi = -pgm_read_word_near(Sinewave + j);
-            wi = -Sinewave[j];
+            wi = -SINE(j);
             if (inverse)
                 wi = -wi;
-            if (shift) {
-                wr >>= 1;
-                wi >>= 1;
-            }
+            wr >>= shift;
+            wi >>= shift;
             for (i=m; i<n; i+=istep) {
                 j = i + l;
                 tr = FIX_MPY(wr,fr[j]) - FIX_MPY(wi,fi[j]);
                 ti = FIX_MPY(wr,fi[j]) + FIX_MPY(wi,fr[j]);
                 qr = fr[i];
                 qi = fi[i];
-                if (shift) {
-                    qr >>= 1;
-                    qi >>= 1;
-                }
+                qr >>= shift;
+                qi >>= shift;
                 fr[j] = qr - tr;
                 fi[j] = qi - ti;
                 fr[i] = qr + tr;
@@ -214,34 +479,156 @@ int16_t fix_fft(int8_t fr[], int8_t fi[], int16_t m, int16_t inverse)
     }
     return scale;
 }
+#endif /* FFT_RADIX4 */
+
+/*
+  fix_interleave() - in-place merge of the even samples in
+  f[0..n/2-1] and the odd samples in f[n/2..n-1] back into
+  natural order. Each cycle of the permutation is rotated once,
+  starting from its smallest index, so no scratch array is
+  needed.
+*/
+static void fix_interleave(int8_t f[], int16_t n)
+{
+    int16_t s, p, q, h = n >> 1;
+    int8_t tt;
+
+    for (s=1; s<n-1; ++s) {
+        /* skip s unless it is the smallest index of its cycle */
+        p = s;
+        do {
+            p = (p & 1) ? h + (p >> 1) : p >> 1;
+        } while (p > s);
+        if (p < s)
+            continue;
+
+        tt = f[s];
+        p = s;
+        for (;;) {
+            q = (p & 1) ? h + (p >> 1) : p >> 1;
+            if (q == s)
+                break;
+            f[p] = f[q];
+            p = q;
+        }
+        f[p] = tt;
+    }
+}
 
 /*
   fix_fftr() - forward/inverse FFT on array of real numbers.
-  Real FFT/iFFT using half-size complex FFT by distributing
-  even/odd samples int16_to real/imaginary arrays respectively.
-  In order to save data space (i.e. to avoid two arrays, one
-  for real, one for imaginary samples), we proceed in the
-  following two steps: a) samples are rearranged in the real
-  array so that all even samples are in places 0-(N/2-1) and
-  all imaginary samples in places (N/2)-(N-1), and b) fix_fft
-  is called with fr and fi point16_ting to index 0 and index N/2
-  respectively in the original array. The above guarantees
-  that fix_fft "sees" consecutive real samples as alternating
-  real and imaginary samples in the complex array.
+  Real FFT/iFFT of n = 2**m samples using one half-size complex
+  FFT: the even samples become the real parts and the odd
+  samples the imaginary parts of an n/2 point complex signal,
+  and the split step below untangles its spectrum Z[] into
+  the spectrum X[] of the real signal. Splitting even/odd
+  samples and then bit-reversing each half is the very same
+  permutation as bit-reversing all n samples, so the forward
+  transform reorders once and runs the butterfly passes of
+  fix_fft() on the two halves directly:
+
+    X[k] = 1/2 (Fe[k] + W^k Fo[k])
+    Fe[k] = 1/2 (Z[k] + Z*[n/2-k]),  Fo[k] = -j/2 (Z[k] - Z*[n/2-k])
+
+  with X[n/2-k] = X*[k] computed from the same pair. The result
+  is the n/2+1 bins 0..n/2 in place, packed as
+
+    f[k]       real part of X[k],      0 <= k < n/2
+    f[n/2+k]   imaginary part of X[k], 0 <  k < n/2
+    f[n/2]     real part of X[n/2] (imaginary parts of X[0]
+               and X[n/2] are always 0)
+
+  Scaling follows fix_fft(): the forward transform is scaled by
+  1/n, just like fix_fft() on n complex samples with zero
+  imaginary parts, and returns 0 (the block exponent with
+  FFT_BLOCK_FLOAT, see above). Samples beyond PEAK_PACK are
+  halved first, for headroom, the return value is then -1: the
+  output is to be shifted 1 bit LEFT, like a block exponent. The inverse takes the packed
+  spectrum and returns the number of bits LEFT by which the
+  samples must be shifted, as fix_fft() does. Sizes are limited
+  to n <= N_WAVE; -1 is returned for larger m.
 */
 int16_t fix_fftr(int8_t f[], int16_t m, int16_t inverse)
 {
-    int16_t i, N = 1<<(m-1), scale = 0;
-    int8_t tt, *fr=f, *fi=&f[N];
+    int16_t k, j, h = 1<<(m-1), scale = 0;
+    int16_t er, ei, dr, di, tr, ti;
+    int8_t *fr=f, *fi=&f[h], wr, wi;
 
-    if (inverse)
-        scale = fix_fft(fi, fr, m-1, inverse);
-    for (i=1; i<N; i+=2) {
-        tt = f[N+i-1];
-        f[N+i-1] = f[i];
-        f[i] = tt;
+    if (m < 1 || m > LOG2_N_WAVE)
+        return -1;
+
+    if (! inverse) {
+#ifndef FFT_BLOCK_FLOAT
+        /* the fixed scaling passes take no headroom of their own */
+        if (fix_peak(fr, fi, h) > PEAK_PACK) {
+            for (k=0; k<(h << 1); ++k)
+                f[k] >>= 1;
+            scale = -1;
+        }
+#endif
+        fix_bitrev(f, m);
+        scale += fix_fft_stages(fr, fi, h, 0);
+#ifdef FFT_BLOCK_FLOAT
+        /* the split below grows its input up to (1+sqrt(2))/2 times */
+        if (fix_peak(fr, fi, h) > 2*PEAK_R2) {
+            for (k=0; k<(h << 1); ++k)
+                f[k] >>= 1;
+            --scale;
+        }
+#endif
+
+        /* bins 0 and n/2 come from Z[0] alone */
+        er = fr[0];
+        ei = fi[0];
+        fr[0] = (er + ei) >> 1;
+        fi[0] = (er - ei) >> 1;
+
+        for (k=1; k<=h/2; ++k) {
+            j = k << (LOG2_N_WAVE-m);
+            /* 0 <= j <= N_WAVE/4 */
+            wr =  SINE(j+N_WAVE/4);
+            wi = -SINE(j);
+            /* Fe = (Z[k] + Z*[h-k])/2, Fo = -j (Z[k] - Z*[h-k])/2 */
+            er = (fr[k] + fr[h-k]) >> 1;
+            ei = (fi[k] - fi[h-k]) >> 1;
+            dr = (fi[k] + fi[h-k]) >> 1;
+            di = (fr[h-k] - fr[k]) >> 1;
+            tr = FIX_MPY(wr,dr) - FIX_MPY(wi,di);
+            ti = FIX_MPY(wr,di) + FIX_MPY(wi,dr);
+            fr[k] = (er + tr) >> 1;
+            fi[k] = (ei + ti) >> 1;
+            fr[h-k] = (er - tr) >> 1;
+            fi[h-k] = (ti - ei) >> 1;
+        }
+    } else {
+        /* Z[0] from X[0] and X[n/2] */
+        er = fr[0];
+        ei = fi[0];
+        fr[0] = (er + ei) >> 1;
+        fi[0] = (er - ei) >> 1;
+
+        for (k=1; k<=h/2; ++k) {
+            j = k << (LOG2_N_WAVE-m);
+            wr = SINE(j+N_WAVE/4);
+            wi = SINE(j);
+            /* Xe = (X[k] + X*[h-k])/2, Xo = W^-k (X[k] - X*[h-k])/2 */
+            er = (fr[k] + fr[h-k]) >> 1;
+            ei = (fi[k] - fi[h-k]) >> 1;
+            dr = (fr[k] - fr[h-k]) >> 1;
+            di = (fi[k] + fi[h-k]) >> 1;
+            /* j Xo */
+            ti = FIX_MPY(wr,dr) - FIX_MPY(wi,di);
+            tr = -(FIX_MPY(wr,di) + FIX_MPY(wi,dr));
+            /* Z[k] = Xe + j Xo, Z[h-k] = (Xe - j Xo)* */
+            fr[k] = er + tr;
+            fi[k] = ei + ti;
+            fr[h-k] = er - tr;
+            fi[h-k] = ti - ei;
+        }
+
+        /* the halving above is made up by one more left shift */
+        scale = fix_fft(fr, fi, m-1, 1) + 1;
+        fix_interleave(f, h << 1);
     }
-    if (! inverse)
-        scale = fix_fft(fi, fr, m-1, inverse);
     return scale;
 }
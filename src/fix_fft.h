@@ -0,0 +1,63 @@
+/* fix_fft.h - Fixed-point in-place Fast Fourier Transform */
+/*
+  FFT_BITS selects the sample width of the implementation
+  linked in: 8 for fix_fft.c (default), 16 for
+  fix_fft.init16_t.c. Both share the same interface and
+  scaling conventions, see fix_fft.c. fix_fft_tmpl.cpp provides it
+  for either width on top of the C++ template in fix_fft.hpp.
+*/
+
+#ifndef FIX_FFT_H
+#define FIX_FFT_H
+
+#include <stdint.h>
+
+#ifndef FFT_BITS
+#define FFT_BITS 8
+#endif
+
+/*
+  LOG2_N_WAVE bounds the largest transform, 2**LOG2_N_WAVE
+  points; a smaller one trims Sinewave[] and the bit-reversal
+  tables of fix_fft_tables.h to the sizes actually used.
+*/
+#if FFT_BITS == 16
+#ifndef LOG2_N_WAVE
+#define LOG2_N_WAVE 10      /* log2(N_WAVE), 2..10 */
+#endif
+typedef int16_t fixed;
+#else
+#ifndef LOG2_N_WAVE
+#define LOG2_N_WAVE 8       /* log2(N_WAVE), 2..8 */
+#endif
+typedef int8_t fixed;
+#endif
+#define N_WAVE      (1 << LOG2_N_WAVE)  /* full length of Sinewave[] */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  Sinewave[] holds sin(2*pi*j/N_WAVE) for 0 <= j < 3*N_WAVE/4,
+  or with -DFFT_QUARTER_WAVE only the quarter wave 0 <= j <=
+  N_WAVE/4 (65 instead of 192 bytes for int8, 514 instead of
+  1536 for int16); fix_sin() reads either for any j.
+*/
+#ifdef FFT_QUARTER_WAVE
+#define SINEWAVE_LEN (N_WAVE/4+1)
+#else
+#define SINEWAVE_LEN (N_WAVE-N_WAVE/4)
+#endif
+extern const fixed Sinewave[SINEWAVE_LEN];
+
+fixed fix_sin(int16_t j);
+fixed FIX_MPY(fixed a, fixed b);
+int16_t fix_fft(fixed fr[], fixed fi[], int16_t m, int16_t inverse);
+int16_t fix_fftr(fixed f[], int16_t m, int16_t inverse);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIX_FFT_H */
@@ -0,0 +1,433 @@
+/* fix_fft.hpp - Fixed-point in-place FFT as a C++ template */
+/*
+  Header-only version of fix_fft.c / fix_fft.init16_t.c,
+  parameterized by the sample type T, the accumulator type Acc
+  of the products and sums, and the size 2**M:
+
+    fixfft::fix_fft<int8_t, int16_t, 6, false>(fr, fi);
+    fixfft::fix_fftr<int16_t, int32_t, 6, false>(f);
+
+  Twiddle factors and bit-reversal swap pairs are computed by
+  constexpr constructors for exactly the size in use, so there
+  is no N_WAVE limit, no size check, and every loop bound is a
+  compile time constant the compiler can unroll for the small
+  sizes. The direction is a template argument too, the forward
+  transform carries no inverse branches nor overflow scans.
+  Sequential lays the twiddles out per pass, for cached hosts,
+  at about twice the table size.
+
+  Arithmetic, scaling and return values are those of the C
+  versions, bit for bit, see fix_fft.c; the twiddles reproduce
+  the values of their Sinewave[] tables. fix_fft_tmpl.cpp wraps it
+  into the C interface of fix_fft.h.
+
+  Needs C++14 (loops in constexpr functions).
+*/
+
+#ifndef FIX_FFT_HPP
+#define FIX_FFT_HPP
+
+#include <stdint.h>
+
+namespace fixfft {
+
+/*
+  traits - per sample type constants. amplitude is the scale
+  the legacy Sinewave[] tables were made with: truncated
+  128*sin clipped to 127 for int8, truncated 32767*sin for
+  int16. overflow is the variable scaling threshold, the
+  largest input peak of an unscaled pass: (1+sqrt(2))*52 < 128
+  for int8, half the range for int16. halved is the largest
+  peak of a pass halved once, (1+sqrt(2))/2*104 < 128 for
+  int8, beyond it the pass is halved twice; int16 keeps the
+  single halving of fix_fft.init16_t.c. pack is the largest
+  sample fix_fftr() packs in pairs without halving them first,
+  max/sqrt(2).
+*/
+template <typename T> struct traits;
+
+template <> struct traits<int8_t> {
+	static constexpr double amplitude = 128.0;
+	static constexpr long max = 127;
+	static constexpr int bits = 8;
+	static constexpr long overflow = 52;
+	static constexpr long halved = 104;
+	static constexpr long pack = 89;
+};
+
+template <> struct traits<int16_t> {
+	static constexpr double amplitude = 32767.0;
+	static constexpr long max = 32767;
+	static constexpr int bits = 16;
+	static constexpr long overflow = 16383;
+	static constexpr long halved = 32767;
+	static constexpr long pack = 23170;
+};
+
+constexpr double pi = 3.14159265358979323846;
+
+// Taylor series, |x| <= pi/4
+constexpr double taylor_sin(double x)
+{
+	double t = x, s = x;
+	for (int i = 1; i < 12; ++i) {
+		t *= -x * x / ((2 * i) * (2 * i + 1));
+		s += t;
+	}
+	return s;
+}
+
+constexpr double taylor_cos(double x)
+{
+	double t = 1, s = 1;
+	for (int i = 1; i < 12; ++i) {
+		t *= -x * x / ((2 * i - 1) * (2 * i));
+		s += t;
+	}
+	return s;
+}
+
+// sin(2*pi*k/n), folded into the first octant; n a multiple of 8
+constexpr double sin2pi(unsigned long k, unsigned long n)
+{
+	double sign = 1;
+
+	k %= n;
+	if (k >= n / 2) {
+		k -= n / 2;
+		sign = -1;
+	}
+	if (k > n / 4)
+		k = n / 2 - k;
+	if (8 * k <= n)
+		return sign * taylor_sin(2 * pi * k / n);
+	return sign * taylor_cos(2 * pi * (n / 4 - k) / n);
+}
+
+template <typename T>
+constexpr T quantize(double x)
+{
+	long v = static_cast<long>(traits<T>::amplitude * x);
+	return static_cast<T>(v > traits<T>::max ? traits<T>::max : v);
+}
+
+/*
+  twiddles - cos and sin of 2*pi*k/2**M for 0 <= k < 2**(M-1),
+  W^k = c[k] - j s[k].
+*/
+template <typename T, unsigned M>
+struct twiddles {
+	T c[1u << (M - 1)];
+	T s[1u << (M - 1)];
+
+	constexpr twiddles() : c(), s()
+	{
+		for (unsigned long k = 0; k < (1ul << (M - 1)); ++k) {
+			c[k] = quantize<T>(sin2pi((k << 3) + (2ul << M), 8ul << M));
+			s[k] = quantize<T>(sin2pi(k << 3, 8ul << M));
+		}
+	}
+};
+
+template <typename T, unsigned M>
+constexpr twiddles<T, M> twiddle_table{};
+
+/*
+  stage_twiddles - the twiddles of the radix-2 passes on 2**L
+  points in the order the passes read them: pass s takes W^m of
+  size 2**(s+1), 0 <= m < 2**s, from c[2**s-1+m] and s[2**s-1+m],
+  one contiguous run per pass instead of a stride through the
+  table of the largest size. Same values as twiddles, 2**L-1
+  entries instead of 2**(L-1), one spare so L = 0 is not empty.
+*/
+template <typename T, unsigned L>
+struct stage_twiddles {
+	T c[1u << L];
+	T s[1u << L];
+
+	constexpr stage_twiddles() : c(), s()
+	{
+		for (unsigned long l = 1; l < (1ul << L); l <<= 1) {
+			for (unsigned long m = 0; m < l; ++m) {
+				c[l - 1 + m] = quantize<T>(sin2pi((m << 3) + (l << 2), l << 4));
+				s[l - 1 + m] = quantize<T>(sin2pi(m << 3, l << 4));
+			}
+		}
+	}
+};
+
+template <typename T, unsigned L>
+constexpr stage_twiddles<T, L> stage_twiddle_table{};
+
+/*
+  pass - the twiddles of pass s of stages(), W^m at c[m << shift]
+  and s[m << shift]: strided through the table of size 2**W, or
+  the contiguous run of stage_twiddles when Sequential.
+*/
+template <typename T, unsigned L, unsigned W, bool Sequential>
+struct pass {
+	const T *c, *s;
+	unsigned shift;
+
+	pass(unsigned stage) : c(twiddle_table<T, W>.c), s(twiddle_table<T, W>.s), shift(W - 1 - stage) {}
+};
+
+template <typename T, unsigned L, unsigned W>
+struct pass<T, L, W, true> {
+	const T *c, *s;
+	static constexpr unsigned shift = 0;
+
+	pass(unsigned stage) : c(stage_twiddle_table<T, L>.c + (1u << stage) - 1),
+		s(stage_twiddle_table<T, L>.s + (1u << stage) - 1) {}
+};
+
+constexpr unsigned reverse(unsigned i, unsigned m)
+{
+	unsigned r = 0;
+	while (m--) {
+		r = (r << 1) | (i & 1);
+		i >>= 1;
+	}
+	return r;
+}
+
+// number of (i, rev(i)) pairs with i < rev(i) of size 2**m
+constexpr unsigned swap_pairs(unsigned m)
+{
+	unsigned count = 0;
+	for (unsigned i = 0; i < (1u << m); ++i)
+		if (i < reverse(i, m))
+			++count;
+	return count;
+}
+
+template <bool Wide> struct index_type { typedef uint16_t type; };
+template <> struct index_type<false> { typedef uint8_t type; };
+
+/*
+  bitrev - the swap pairs of size 2**M, one spare entry so the
+  array is never empty.
+*/
+template <unsigned M>
+struct bitrev {
+	typedef typename index_type<(M > 8)>::type index;
+	static constexpr unsigned pairs = swap_pairs(M);
+	index pair[2 * pairs + 1];
+
+	constexpr bitrev() : pair()
+	{
+		unsigned p = 0;
+		for (unsigned i = 0; i < (1u << M); ++i) {
+			if (i < reverse(i, M)) {
+				pair[p++] = i;
+				pair[p++] = reverse(i, M);
+			}
+		}
+	}
+};
+
+template <unsigned M>
+constexpr bitrev<M> bitrev_table{};
+
+// FIX_MPY() - a*b scaled back to T, rounded by the last bit out
+template <typename T, typename Acc>
+inline T mpy(T a, T b)
+{
+	Acc c = static_cast<Acc>(static_cast<Acc>(a) * b) >> (traits<T>::bits - 2);
+	return static_cast<T>((c >> 1) + (c & 1));
+}
+
+template <typename T, unsigned M>
+inline void reorder(T f[])
+{
+	const bitrev<M> &r = bitrev_table<M>;
+	for (unsigned p = 0; p < 2 * bitrev<M>::pairs; p += 2) {
+		T t = f[r.pair[p]];
+		f[r.pair[p]] = f[r.pair[p + 1]];
+		f[r.pair[p + 1]] = t;
+	}
+}
+
+template <typename T>
+inline bool overflow(const T fr[], const T fi[], unsigned n, long limit = traits<T>::overflow)
+{
+	for (unsigned i = 0; i < n; ++i) {
+		long j = fr[i] < 0 ? -fr[i] : fr[i];
+		long m = fi[i] < 0 ? -fi[i] : fi[i];
+		if (j > limit || m > limit)
+			return true;
+	}
+	return false;
+}
+
+// bits a pass halves its input by, 0..2, see fix_shift() of fix_fft.c
+template <typename T>
+inline unsigned shift_bits(const T fr[], const T fi[], unsigned n)
+{
+	if (overflow(fr, fi, n, traits<T>::halved))
+		return 2;
+	return overflow(fr, fi, n) ? 1 : 0;
+}
+
+/*
+  stages() - radix-2 butterfly passes on 2**L points in
+  bit-reversed order, twiddles taken from the table of size
+  2**W, W >= L, or from stage_twiddles when Sequential. Block
+  selects the block floating point forward scaling of
+  -DFFT_BLOCK_FLOAT.
+*/
+template <typename T, typename Acc, unsigned L, unsigned W, bool Inverse, bool Block = false, bool Sequential = false>
+inline int16_t stages(T fr[], T fi[])
+{
+	constexpr unsigned n = 1u << L;
+	int16_t scale = 0;
+	unsigned s, l, m, i, j;
+
+	for (s = 0, l = 1; l < n; ++s, l <<= 1) {
+		// fixed scaling forward, variable scaling inverse
+		unsigned shift = !Inverse && !Block ? 1 : shift_bits(fr, fi, n);
+		scale += Inverse ? shift : 1 - (int16_t)shift;
+		const pass<T, L, W, Sequential> w(s);
+		for (m = 0; m < l; ++m) {
+			j = m << w.shift;
+			T wr = w.c[j];
+			T wi = Inverse ? w.s[j] : -w.s[j];
+			wr >>= shift;
+			wi >>= shift;
+			for (i = m; i < n; i += l << 1) {
+				j = i + l;
+				T tr = mpy<T, Acc>(wr, fr[j]) - mpy<T, Acc>(wi, fi[j]);
+				T ti = mpy<T, Acc>(wr, fi[j]) + mpy<T, Acc>(wi, fr[j]);
+				T qr = fr[i];
+				T qi = fi[i];
+				qr >>= shift;
+				qi >>= shift;
+				fr[j] = qr - tr;
+				fi[j] = qi - ti;
+				fr[i] = qr + tr;
+				fi[i] = qi + ti;
+			}
+		}
+	}
+	return scale;
+}
+
+// fix_fft() - complex FFT/iFFT of 2**M points, see fix_fft.c
+template <typename T, typename Acc, unsigned M, bool Inverse, bool Block = false, bool Sequential = false>
+inline int16_t fix_fft(T fr[], T fi[])
+{
+	reorder<T, M>(fr);
+	reorder<T, M>(fi);
+	return stages<T, Acc, M, M, Inverse, Block, Sequential>(fr, fi);
+}
+
+// interleave() - even samples in f[0..n/2-1], odd ones in f[n/2..n-1] back in order
+template <typename T>
+inline void interleave(T f[], unsigned n)
+{
+	unsigned s, p, q, h = n >> 1;
+
+	for (s = 1; s + 1 < n; ++s) {
+		p = s;
+		do {
+			p = (p & 1) ? h + (p >> 1) : p >> 1;
+		} while (p > s);
+		if (p < s)
+			continue;
+
+		T t = f[s];
+		p = s;
+		for (;;) {
+			q = (p & 1) ? h + (p >> 1) : p >> 1;
+			if (q == s)
+				break;
+			f[p] = f[q];
+			p = q;
+		}
+		f[p] = t;
+	}
+}
+
+/*
+  fix_fftr() - real FFT/iFFT of 2**M samples through a 2**(M-1)
+  point complex FFT, same packing and scaling as fix_fftr() in
+  fix_fft.c.
+*/
+template <typename T, typename Acc, unsigned M, bool Inverse, bool Block = false, bool Sequential = false>
+inline int16_t fix_fftr(T f[])
+{
+	static_assert(M >= 1, "fix_fftr needs at least 2 samples");
+	constexpr unsigned h = 1u << (M - 1);
+	const twiddles<T, M> &w = twiddle_table<T, M>;
+	T *fr = f, *fi = f + h;
+	Acc er, ei, dr, di, tr, ti;
+	int16_t scale = 0;
+	unsigned k;
+
+	if (!Inverse) {
+		// the fixed scaling passes take no headroom of their own
+		if (!Block && overflow(fr, fi, h, traits<T>::pack)) {
+			for (k = 0; k < 2 * h; ++k)
+				f[k] >>= 1;
+			scale = -1;
+		}
+		reorder<T, M>(f);
+		scale += stages<T, Acc, M - 1, M, false, Block, Sequential>(fr, fi);
+		// the split grows its input up to (1+sqrt(2))/2 times
+		if (Block && overflow(fr, fi, h, 2 * traits<T>::overflow)) {
+			for (k = 0; k < 2 * h; ++k)
+				f[k] >>= 1;
+			--scale;
+		}
+
+		// bins 0 and n/2 come from Z[0] alone
+		er = fr[0];
+		ei = fi[0];
+		fr[0] = (er + ei) >> 1;
+		fi[0] = (er - ei) >> 1;
+
+		for (k = 1; k <= h / 2; ++k) {
+			T wr = w.c[k], wi = -w.s[k];
+			// sums in Acc, an int is 16 bits on the MSP430
+			er = (static_cast<Acc>(fr[k]) + fr[h - k]) >> 1;
+			ei = (static_cast<Acc>(fi[k]) - fi[h - k]) >> 1;
+			dr = (static_cast<Acc>(fi[k]) + fi[h - k]) >> 1;
+			di = (static_cast<Acc>(fr[h - k]) - fr[k]) >> 1;
+			tr = static_cast<Acc>(mpy<T, Acc>(wr, dr)) - mpy<T, Acc>(wi, di);
+			ti = static_cast<Acc>(mpy<T, Acc>(wr, di)) + mpy<T, Acc>(wi, dr);
+			fr[k] = (er + tr) >> 1;
+			fi[k] = (ei + ti) >> 1;
+			fr[h - k] = (er - tr) >> 1;
+			fi[h - k] = (ti - ei) >> 1;
+		}
+	} else {
+		er = fr[0];
+		ei = fi[0];
+		fr[0] = (er + ei) >> 1;
+		fi[0] = (er - ei) >> 1;
+
+		for (k = 1; k <= h / 2; ++k) {
+			T wr = w.c[k], wi = w.s[k];
+			er = (static_cast<Acc>(fr[k]) + fr[h - k]) >> 1;
+			ei = (static_cast<Acc>(fi[k]) - fi[h - k]) >> 1;
+			dr = (static_cast<Acc>(fr[k]) - fr[h - k]) >> 1;
+			di = (static_cast<Acc>(fi[k]) + fi[h - k]) >> 1;
+			ti = static_cast<Acc>(mpy<T, Acc>(wr, dr)) - mpy<T, Acc>(wi, di);
+			tr = -(static_cast<Acc>(mpy<T, Acc>(wr, di)) + mpy<T, Acc>(wi, dr));
+			fr[k] = er + tr;
+			fi[k] = ei + ti;
+			fr[h - k] = er - tr;
+			fi[h - k] = ti - ei;
+		}
+
+		reorder<T, M - 1>(fr);
+		reorder<T, M - 1>(fi);
+		scale = stages<T, Acc, M - 1, M, true, false, Sequential>(fr, fi) + 1;
+		interleave(f, h << 1);
+	}
+	return scale;
+}
+
+} // namespace fixfft
+
+#endif /* FIX_FFT_HPP */
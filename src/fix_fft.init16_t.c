@@ -28,10 +28,11 @@
   Enhanced:  Dimitrios P. Bouras  14 Jun 2006 dbouras@ieee.org
 */
 
-#define N_WAVE      1024    /* full length of Sinewave[] */
-#define LOG2_N_WAVE 10      /* log2(N_WAVE) */
+#define FFT_BITS 16
 
 #include <stdint.h>
+#include "fix_fft.h"
+#include "fix_fft_tables.h"
 /*
   Henceforth "short" implies 16-bit word. If this is not
   the case in your architecture, please replace "short"
@@ -39,107 +40,42 @@
 */
 
 /*
-  Since we only use 3/4 of N_WAVE, we define only
-  this many samples, in order to conserve data space.
+  Largest |sample| fix_fftr() packs in pairs into the complex
+  points of the fixed scaling passes: these keep the modulus of
+  a point within that of their input, which must stay below
+  32768, 32767/sqrt(2) for two full scale samples.
 */
-const int16_t Sinewave[N_WAVE-N_WAVE/4] = {
-      0,    201,    402,    603,    804,   1005,   1206,   1406,
-   1607,   1808,   2009,   2209,   2410,   2610,   2811,   3011,
-   3211,   3411,   3611,   3811,   4011,   4210,   4409,   4608,
-   4807,   5006,   5205,   5403,   5601,   5799,   5997,   6195,
-   6392,   6589,   6786,   6982,   7179,   7375,   7571,   7766,
-   7961,   8156,   8351,   8545,   8739,   8932,   9126,   9319,
-   9511,   9703,   9895,  10087,  10278,  10469,  10659,  10849,
-  11038,  11227,  11416,  11604,  11792,  11980,  12166,  12353,
-  12539,  12724,  12909,  13094,  13278,  13462,  13645,  13827,
-  14009,  14191,  14372,  14552,  14732,  14911,  15090,  15268,
-  15446,  15623,  15799,  15975,  16150,  16325,  16499,  16672,
-  16845,  17017,  17189,  17360,  17530,  17699,  17868,  18036,
-  18204,  18371,  18537,  18702,  18867,  19031,  19194,  19357,
-  19519,  19680,  19840,  20000,  20159,  20317,  20474,  20631,
-  20787,  20942,  21096,  21249,  21402,  21554,  21705,  21855,
-  22004,  22153,  22301,  22448,  22594,  22739,  22883,  23027,
-  23169,  23311,  23452,  23592,  23731,  23869,  24006,  24143,
-  24278,  24413,  24546,  24679,  24811,  24942,  25072,  25201,
-  25329,  25456,  25582,  25707,  25831,  25954,  26077,  26198,
-  26318,  26437,  26556,  26673,  26789,  26905,  27019,  27132,
-  27244,  27355,  27466,  27575,  27683,  27790,  27896,  28001,
-  28105,  28208,  28309,  28410,  28510,  28608,  28706,  28802,
-  28897,  28992,  29085,  29177,  29268,  29358,  29446,  29534,
-  29621,  29706,  29790,  29873,  29955,  30036,  30116,  30195,
-  30272,  30349,  30424,  30498,  30571,  30643,  30713,  30783,
-  30851,  30918,  30984,  31049,  31113,  31175,  31236,  31297,
-  31356,  31413,  31470,  31525,  31580,  31633,  31684,  31735,
-  31785,  31833,  31880,  31926,  31970,  32014,  32056,  32097,
-  32137,  32176,  32213,  32249,  32284,  32318,  32350,  32382,
-  32412,  32441,  32468,  32495,  32520,  32544,  32567,  32588,
-  32609,  32628,  32646,  32662,  32678,  32692,  32705,  32717,
-  32727,  32736,  32744,  32751,  32757,  32761,  32764,  32766,
-  32767,  32766,  32764,  32761,  32757,  32751,  32744,  32736,
-  32727,  32717,  32705,  32692,  32678,  32662,  32646,  32628,
-  32609,  32588,  32567,  32544,  32520,  32495,  32468,  32441,
-  32412,  32382,  32350,  32318,  32284,  32249,  32213,  32176,
-  32137,  32097,  32056,  32014,  31970,  31926,  31880,  31833,
-  31785,  31735,  31684,  31633,  31580,  31525,  31470,  31413,
-  31356,  31297,  31236,  31175,  31113,  31049,  30984,  30918,
-  30851,  30783,  30713,  30643,  30571,  30498,  30424,  30349,
-  30272,  30195,  30116,  30036,  29955,  29873,  29790,  29706,
-  29621,  29534,  29446,  29358,  29268,  29177,  29085,  28992,
-  28897,  28802,  28706,  28608,  28510,  28410,  28309,  28208,
-  28105,  28001,  27896,  27790,  27683,  27575,  27466,  27355,
-  27244,  27132,  27019,  26905,  26789,  26673,  26556,  26437,
-  26318,  26198,  26077,  25954,  25831,  25707,  25582,  25456,
-  25329,  25201,  25072,  24942,  24811,  24679,  24546,  24413,
-  24278,  24143,  24006,  23869,  23731,  23592,  23452,  23311,
-  23169,  23027,  22883,  22739,  22594,  22448,  22301,  22153,
-  22004,  21855,  21705,  21554,  21402,  21249,  21096,  20942,
-  20787,  20631,  20474,  20317,  20159,  20000,  19840,  19680,
-  19519,  19357,  19194,  19031,  18867,  18702,  18537,  18371,
-  18204,  18036,  17868,  17699,  17530,  17360,  17189,  17017,
-  16845,  16672,  16499,  16325,  16150,  15975,  15799,  15623,
-  15446,  15268,  15090,  14911,  14732,  14552,  14372,  14191,
-  14009,  13827,  13645,  13462,  13278,  13094,  12909,  12724,
-  12539,  12353,  12166,  11980,  11792,  11604,  11416,  11227,
-  11038,  10849,  10659,  10469,  10278,  10087,   9895,   9703,
-   9511,   9319,   9126,   8932,   8739,   8545,   8351,   8156,
-   7961,   7766,   7571,   7375,   7179,   6982,   6786,   6589,
-   6392,   6195,   5997,   5799,   5601,   5403,   5205,   5006,
-   4807,   4608,   4409,   4210,   4011,   3811,   3611,   3411,
-   3211,   3011,   2811,   2610,   2410,   2209,   2009,   1808,
-   1607,   1406,   1206,   1005,    804,    603,    402,    201,
-      0,   -201,   -402,   -603,   -804,  -1005,  -1206,  -1406,
-  -1607,  -1808,  -2009,  -2209,  -2410,  -2610,  -2811,  -3011,
-  -3211,  -3411,  -3611,  -3811,  -4011,  -4210,  -4409,  -4608,
-  -4807,  -5006,  -5205,  -5403,  -5601,  -5799,  -5997,  -6195,
-  -6392,  -6589,  -6786,  -6982,  -7179,  -7375,  -7571,  -7766,
-  -7961,  -8156,  -8351,  -8545,  -8739,  -8932,  -9126,  -9319,
-  -9511,  -9703,  -9895, -10087, -10278, -10469, -10659, -10849,
- -11038, -11227, -11416, -11604, -11792, -11980, -12166, -12353,
- -12539, -12724, -12909, -13094, -13278, -13462, -13645, -13827,
- -14009, -14191, -14372, -14552, -14732, -14911, -15090, -15268,
- -15446, -15623, -15799, -15975, -16150, -16325, -16499, -16672,
- -16845, -17017, -17189, -17360, -17530, -17699, -17868, -18036,
- -18204, -18371, -18537, -18702, -18867, -19031, -19194, -19357,
- -19519, -19680, -19840, -20000, -20159, -20317, -20474, -20631,
- -20787, -20942, -21096, -21249, -21402, -21554, -21705, -21855,
- -22004, -22153, -22301, -22448, -22594, -22739, -22883, -23027,
- -23169, -23311, -23452, -23592, -23731, -23869, -24006, -24143,
- -24278, -24413, -24546, -24679, -24811, -24942, -25072, -25201,
- -25329, -25456, -25582, -25707, -25831, -25954, -26077, -26198,
- -26318, -26437, -26556, -26673, -26789, -26905, -27019, -27132,
- -27244, -27355, -27466, -27575, -27683, -27790, -27896, -28001,
- -28105, -28208, -28309, -28410, -28510, -28608, -28706, -28802,
- -28897, -28992, -29085, -29177, -29268, -29358, -29446, -29534,
- -29621, -29706, -29790, -29873, -29955, -30036, -30116, -30195,
- -30272, -30349, -30424, -30498, -30571, -30643, -30713, -30783,
- -30851, -30918, -30984, -31049, -31113, -31175, -31236, -31297,
- -31356, -31413, -31470, -31525, -31580, -31633, -31684, -31735,
- -31785, -31833, -31880, -31926, -31970, -32014, -32056, -32097,
- -32137, -32176, -32213, -32249, -32284, -32318, -32350, -32382,
- -32412, -32441, -32468, -32495, -32520, -32544, -32567, -32588,
- -32609, -32628, -32646, -32662, -32678, -32692, -32705, -32717,
- -32727, -32736, -32744, -32751, -32757, -32761, -32764, -32766,
-};
+#define PEAK_PACK 23170
+
+/*
+  Since we only use 3/4 of N_WAVE, Sinewave[] of fix_fft_tables.h
+  holds only this many samples, in order to conserve data space.
+  -DFFT_QUARTER_WAVE keeps just the first quarter, SINE() then
+  folds the twiddle factors out of it by symmetry.
+*/
+#ifdef FFT_QUARTER_WAVE
+#define SINE(j) fix_sin(j)
+#else
+#define SINE(j) Sinewave[j]
+#endif
+
+/*
+  fix_sin() - sin(2*pi*j/N_WAVE) for any j, by sin(x) = -sin(x-pi)
+  and sin(x) = sin(pi-x) from the part of the wave in Sinewave[].
+*/
+int16_t fix_sin(int16_t j)
+{
+	j &= N_WAVE-1;
+#ifdef FFT_QUARTER_WAVE
+	if (j & N_WAVE/2)
+		return (j & (N_WAVE/2-1)) > N_WAVE/4 ? -Sinewave[N_WAVE-j] : -Sinewave[j-N_WAVE/2];
+	return j > N_WAVE/4 ? Sinewave[N_WAVE/2-j] : Sinewave[j];
+#else
+	if (j < N_WAVE-N_WAVE/4)
+		return Sinewave[j];
+	return -Sinewave[j-N_WAVE/2];
+#endif
+}
 
 /*
   FIX_MPY() - fixed-point multiplication & scaling.
@@ -149,8 +85,8 @@ const int16_t Sinewave[N_WAVE-N_WAVE/4] = {
 */
 int16_t FIX_MPY(int16_t a, int16_t b)
 {
-	/* shift right one less bit (i.e. 15-1) */
-	int c = ((int)a * (int)b) >> 14;
+	/* shift right one less bit (i.e. 15-1), 32 bit product */
+	int32_t c = ((int32_t)a * (int32_t)b) >> 14;
 	/* last bit shifted out = rounding-bit */
 	b = c & 0x01;
 	/* last shift + rounding bit */
@@ -158,16 +94,58 @@ int16_t FIX_MPY(int16_t a, int16_t b)
 	return a;
 }
 
+static int16_t fix_fft_stages(int16_t fr[], int16_t fi[], int16_t n, int16_t inverse);
+
+/*
+  fix_bitrev() - bit-reversed reorder of f[0..2**m-1], the
+  re-order step of fix_fft() on a single array. Sizes up to
+  BITREV_MAX_M walk the swap pairs of fix_fft_tables.h, larger
+  ones compute the reversed index.
+*/
+static void fix_bitrev(int16_t f[], int16_t m)
+{
+	int16_t mr, nn, l, n, i;
+	int16_t tt;
+	const bitrev_t *p, *end;
+
+	if (m <= BITREV_MAX_M) {
+		p = bitrev_pairs + 2*bitrev_start[m];
+		end = bitrev_pairs + 2*bitrev_start[m+1];
+		for (; p < end; p += 2) {
+			tt = f[p[0]];
+			f[p[0]] = f[p[1]];
+			f[p[1]] = tt;
+		}
+		return;
+	}
+
+	n = 1 << m;
+	mr = 0;
+	nn = n - 1;
+	for (i=1; i<=nn; ++i) {
+		l = n;
+		do {
+			l >>= 1;
+		} while (mr+l > nn);
+		mr = (mr & (l-1)) + l;
+
+		if (mr <= i)
+			continue;
+		tt = f[i];
+		f[i] = f[mr];
+		f[mr] = tt;
+	}
+}
+
 /*
   fix_fft() - perform forward/inverse fast Fourier transform.
   fr[n],fi[n] are real and imaginary arrays, both INPUT AND
   RESULT (in-place FFT), with 0 <= n < 2**m; set inverse to
   0 for forward transform (FFT), or 1 for iFFT.
 */
-int fix_fft(int16_t fr[], int16_t fi[], short m, short inverse)
+int16_t fix_fft(int16_t fr[], int16_t fi[], int16_t m, int16_t inverse)
 {
-	int mr, nn, i, j, l, k, istep, n, scale, shift;
-	short qr, qi, tr, ti, wr, wi;
+	int16_t n;
 
 	n = 1 << m;
 
@@ -175,28 +153,23 @@ int fix_fft(int16_t fr[], int16_t fi[], short m, short inverse)
 	if (n > N_WAVE)
 		return -1;
 
-	mr = 0;
-	nn = n - 1;
-	scale = 0;
-
 	/* decimation in time - re-order data */
-	for (m=1; m<=nn; ++m) {
-		l = n;
-		do {
-			l >>= 1;
-		} while (mr+l > nn);
-		mr = (mr & (l-1)) + l;
+	fix_bitrev(fr, m);
+	fix_bitrev(fi, m);
 
-		if (mr <= m)
-			continue;
-		tr = fr[m];
-		fr[m] = fr[mr];
-		fr[mr] = tr;
-		ti = fi[m];
-		fi[m] = fi[mr];
-		fi[mr] = ti;
-	}
+	return fix_fft_stages(fr, fi, n, inverse);
+}
+
+/*
+  fix_fft_stages() - butterfly passes of fix_fft() on n points
+  that are already in bit-reversed order.
+*/
+static int16_t fix_fft_stages(int16_t fr[], int16_t fi[], int16_t n, int16_t inverse)
+{
+	int m, i, j, l, k, istep, scale, shift;
+	short qr, qi, tr, ti, wr, wi;
 
+	scale = 0;
 	l = 1;
 	k = LOG2_N_WAVE-1;
 	while (l < n) {
@@ -235,8 +208,8 @@ int fix_fft(int16_t fr[], int16_t fi[], short m, short inverse)
 		for (m=0; m<l; ++m) {
 			j = m << k;
 			/* 0 <= j < N_WAVE/2 */
-			wr =  Sinewave[j+N_WAVE/4];
-			wi = -Sinewave[j];
+			wr =  SINE(j+N_WAVE/4);
+			wi = -SINE(j);
 			if (inverse)
 				wi = -wi;
 			if (shift) {
@@ -265,33 +238,147 @@ int fix_fft(int16_t fr[], int16_t fi[], short m, short inverse)
 	return scale;
 }
 
+/*
+  fix_interleave() - in-place merge of the even samples in
+  f[0..n/2-1] and the odd samples in f[n/2..n-1] back into
+  natural order. Each cycle of the permutation is rotated once,
+  starting from its smallest index, so no scratch array is
+  needed.
+*/
+static void fix_interleave(int16_t f[], int16_t n)
+{
+	int16_t s, p, q, h = n >> 1;
+	int16_t tt;
+
+	for (s=1; s<n-1; ++s) {
+		/* skip s unless it is the smallest index of its cycle */
+		p = s;
+		do {
+			p = (p & 1) ? h + (p >> 1) : p >> 1;
+		} while (p > s);
+		if (p < s)
+			continue;
+
+		tt = f[s];
+		p = s;
+		for (;;) {
+			q = (p & 1) ? h + (p >> 1) : p >> 1;
+			if (q == s)
+				break;
+			f[p] = f[q];
+			p = q;
+		}
+		f[p] = tt;
+	}
+}
+
 /*
   fix_fftr() - forward/inverse FFT on array of real numbers.
-  Real FFT/iFFT using half-size complex FFT by distributing
-  even/odd samples into real/imaginary arrays respectively.
-  In order to save data space (i.e. to avoid two arrays, one
-  for real, one for imaginary samples), we proceed in the
-  following two steps: a) samples are rearranged in the real
-  array so that all even samples are in places 0-(N/2-1) and
-  all imaginary samples in places (N/2)-(N-1), and b) fix_fft
-  is called with fr and fi pointing to index 0 and index N/2
-  respectively in the original array. The above guarantees
-  that fix_fft "sees" consecutive real samples as alternating
-  real and imaginary samples in the complex array.
+  Real FFT/iFFT of n = 2**m samples using one half-size complex
+  FFT: the even samples become the real parts and the odd
+  samples the imaginary parts of an n/2 point complex signal,
+  and the split step below untangles its spectrum Z[] into
+  the spectrum X[] of the real signal. Splitting even/odd
+  samples and then bit-reversing each half is the very same
+  permutation as bit-reversing all n samples, so the forward
+  transform reorders once and runs the butterfly passes of
+  fix_fft() on the two halves directly:
+
+	X[k] = 1/2 (Fe[k] + W^k Fo[k])
+	Fe[k] = 1/2 (Z[k] + Z*[n/2-k]),  Fo[k] = -j/2 (Z[k] - Z*[n/2-k])
+
+  with X[n/2-k] = X*[k] computed from the same pair. The result
+  is the n/2+1 bins 0..n/2 in place, packed as
+
+	f[k]	   real part of X[k],	  0 <= k < n/2
+	f[n/2+k]   imaginary part of X[k], 0 <  k < n/2
+	f[n/2]	 real part of X[n/2] (imaginary parts of X[0]
+			   and X[n/2] are always 0)
+
+  Scaling follows fix_fft(): the forward transform is scaled by
+  1/n, just like fix_fft() on n complex samples with zero
+  imaginary parts, and returns 0. Samples beyond PEAK_PACK are
+  halved first, for headroom, the return value is then -1: the
+  output is to be shifted 1 bit LEFT. The inverse takes the packed
+  spectrum and returns the number of bits LEFT by which the
+  samples must be shifted, as fix_fft() does. Sizes are limited
+  to n <= N_WAVE; -1 is returned for larger m.
 */
-int fix_fftr(int16_t f[], int m, int inverse)
+int16_t fix_fftr(int16_t f[], int16_t m, int16_t inverse)
 {
-	int i, N = 1<<(m-1), scale = 0;
-	int16_t tt, *fr=f, *fi=&f[N];
-
-	if (inverse)
-		scale = fix_fft(fi, fr, m-1, inverse);
-	for (i=1; i<N; i+=2) {
-		tt = f[N+i-1];
-		f[N+i-1] = f[i];
-		f[i] = tt;
+	int16_t k, j, h = 1<<(m-1), scale = 0;
+	int32_t er, ei, dr, di, tr, ti;
+	int16_t *fr=f, *fi=&f[h], wr, wi;
+
+	if (m < 1 || m > LOG2_N_WAVE)
+		return -1;
+
+	if (! inverse) {
+		/* the fixed scaling passes take no headroom of their own */
+		for (k=0; k<(h << 1); ++k)
+			if (f[k] > PEAK_PACK || f[k] < -PEAK_PACK)
+				break;
+		if (k < (h << 1)) {
+			for (k=0; k<(h << 1); ++k)
+				f[k] >>= 1;
+			scale = -1;
+		}
+		fix_bitrev(f, m);
+		fix_fft_stages(fr, fi, h, 0);
+
+		/* bins 0 and n/2 come from Z[0] alone */
+		er = fr[0];
+		ei = fi[0];
+		fr[0] = (er + ei) >> 1;
+		fi[0] = (er - ei) >> 1;
+
+		for (k=1; k<=h/2; ++k) {
+			j = k << (LOG2_N_WAVE-m);
+			/* 0 <= j <= N_WAVE/4 */
+			wr =  SINE(j+N_WAVE/4);
+			wi = -SINE(j);
+			/* Fe = (Z[k] + Z*[h-k])/2, Fo = -j (Z[k] - Z*[h-k])/2 */
+			/* 32 bit sums, an int is 16 bits on the MSP430 */
+			er = ((int32_t)fr[k] + fr[h-k]) >> 1;
+			ei = ((int32_t)fi[k] - fi[h-k]) >> 1;
+			dr = ((int32_t)fi[k] + fi[h-k]) >> 1;
+			di = ((int32_t)fr[h-k] - fr[k]) >> 1;
+			tr = (int32_t)FIX_MPY(wr,dr) - FIX_MPY(wi,di);
+			ti = (int32_t)FIX_MPY(wr,di) + FIX_MPY(wi,dr);
+			fr[k] = (er + tr) >> 1;
+			fi[k] = (ei + ti) >> 1;
+			fr[h-k] = (er - tr) >> 1;
+			fi[h-k] = (ti - ei) >> 1;
+		}
+	} else {
+		/* Z[0] from X[0] and X[n/2] */
+		er = fr[0];
+		ei = fi[0];
+		fr[0] = (er + ei) >> 1;
+		fi[0] = (er - ei) >> 1;
+
+		for (k=1; k<=h/2; ++k) {
+			j = k << (LOG2_N_WAVE-m);
+			wr = SINE(j+N_WAVE/4);
+			wi = SINE(j);
+			/* Xe = (X[k] + X*[h-k])/2, Xo = W^-k (X[k] - X*[h-k])/2 */
+			er = ((int32_t)fr[k] + fr[h-k]) >> 1;
+			ei = ((int32_t)fi[k] - fi[h-k]) >> 1;
+			dr = ((int32_t)fr[k] - fr[h-k]) >> 1;
+			di = ((int32_t)fi[k] + fi[h-k]) >> 1;
+			/* j Xo */
+			ti = (int32_t)FIX_MPY(wr,dr) - FIX_MPY(wi,di);
+			tr = -((int32_t)FIX_MPY(wr,di) + FIX_MPY(wi,dr));
+			/* Z[k] = Xe + j Xo, Z[h-k] = (Xe - j Xo)* */
+			fr[k] = er + tr;
+			fi[k] = ei + ti;
+			fr[h-k] = er - tr;
+			fi[h-k] = ti - ei;
+		}
+
+		/* the halving above is made up by one more left shift */
+		scale = fix_fft(fr, fi, m-1, 1) + 1;
+		fix_interleave(f, h << 1);
 	}
-	if (! inverse)
-		scale = fix_fft(fi, fr, m-1, inverse);
 	return scale;
 }
@@ -0,0 +1,120 @@
+/* fix_fft_tmpl.cpp - C interface of fix_fft.h on top of fix_fft.hpp */
+/*
+  Drop-in replacement for fix_fft.c (FFT_BITS 8) or
+  fix_fft.init16_t.c (FFT_BITS 16): fix_fft(), fix_fftr() and
+  FIX_MPY() with the same arguments, scaling and results, each
+  size dispatched to its own specialization of the template.
+
+  Every specialization brings its own code and tables, so only
+  the sizes FFT_TMPL_MIN_M..FFT_TMPL_MAX_M are built (default
+  1..LOG2_N_WAVE); other sizes return -1. The firmware calls
+  fix_fftr() with m = LOG2N_MIN..LOG2N_MAX of spectrum.h only,
+  build it with -DFFT_TMPL_MIN_M=5 -DFFT_TMPL_MAX_M=7. Sinewave[] is not
+  provided, the twiddles come from per size tables instead;
+  fix_sin() reads the one of 2**LOG2_N_WAVE points.
+  -DFFT_BLOCK_FLOAT applies to FFT_BITS 8, as in fix_fft.c. The
+  host build reads the twiddles from the stage ordered tables,
+  the MSP430 one from the smaller shared tables.
+*/
+
+#include <stdint.h>
+#include "fix_fft.h"
+#include "fix_fft.hpp"
+
+#if FFT_BITS == 16
+typedef int32_t acc;
+#else
+typedef int16_t acc;
+#endif
+
+#if defined(FFT_BLOCK_FLOAT) && FFT_BITS == 8
+static constexpr bool block = true;
+#else
+static constexpr bool block = false;
+#endif
+
+// stage ordered twiddles where a cache rewards it, the smaller tables on the MSP430
+#ifdef __MSP430__
+static constexpr bool sequential = false;
+#else
+static constexpr bool sequential = true;
+#endif
+
+#ifndef FFT_TMPL_MIN_M
+#define FFT_TMPL_MIN_M 1
+#endif
+#ifndef FFT_TMPL_MAX_M
+#define FFT_TMPL_MAX_M LOG2_N_WAVE
+#endif
+
+static_assert(FFT_TMPL_MIN_M >= 1 && FFT_TMPL_MIN_M <= FFT_TMPL_MAX_M,
+	"FFT_TMPL_MIN_M..FFT_TMPL_MAX_M is not a range of sizes");
+
+namespace {
+
+// m == M or on to the next smaller size
+template <int M>
+struct dispatch {
+	static int16_t fft(fixed fr[], fixed fi[], int16_t m, int16_t inverse)
+	{
+		if (m != M)
+			return dispatch<M - 1>::fft(fr, fi, m, inverse);
+		if (inverse)
+			return fixfft::fix_fft<fixed, acc, M, true, false, sequential>(fr, fi);
+		return fixfft::fix_fft<fixed, acc, M, false, block, sequential>(fr, fi);
+	}
+
+	static int16_t fftr(fixed f[], int16_t m, int16_t inverse)
+	{
+		if (m != M)
+			return dispatch<M - 1>::fftr(f, m, inverse);
+		if (inverse)
+			return fixfft::fix_fftr<fixed, acc, M, true, false, sequential>(f);
+		return fixfft::fix_fftr<fixed, acc, M, false, block, sequential>(f);
+	}
+};
+
+template <>
+struct dispatch<FFT_TMPL_MIN_M - 1> {
+	static int16_t fft(fixed [], fixed [], int16_t, int16_t)
+	{
+		return -1;
+	}
+
+	static int16_t fftr(fixed [], int16_t, int16_t)
+	{
+		return -1;
+	}
+};
+
+} // namespace
+
+/*
+  fix_sin() - sin(2*pi*j/N_WAVE) for any j, by sin(x) = -sin(x-pi)
+  from the sines of the twiddles of N_WAVE points, the values of
+  fix_sin() of fix_fft.c.
+*/
+fixed fix_sin(int16_t j)
+{
+	const fixfft::twiddles<fixed, LOG2_N_WAVE> &w = fixfft::twiddle_table<fixed, LOG2_N_WAVE>;
+
+	j &= N_WAVE - 1;
+	if (j < N_WAVE / 2)
+		return w.s[j];
+	return -w.s[j - N_WAVE / 2];
+}
+
+fixed FIX_MPY(fixed a, fixed b)
+{
+	return fixfft::mpy<fixed, acc>(a, b);
+}
+
+int16_t fix_fft(fixed fr[], fixed fi[], int16_t m, int16_t inverse)
+{
+	return dispatch<FFT_TMPL_MAX_M>::fft(fr, fi, m, inverse);
+}
+
+int16_t fix_fftr(fixed f[], int16_t m, int16_t inverse)
+{
+	return dispatch<FFT_TMPL_MAX_M>::fftr(f, m, inverse);
+}
@@ -0,0 +1,117 @@
+/* goertzel.c - Fixed-point Goertzel filters for a few tones */
+/*
+  Each tone is a resonator tuned to w = 2*pi*hz/rate:
+
+    s[i] = x[i] + 2 cos(w) s[i-1] - s[i-2]
+
+  After the n samples of a block the DFT of the block at w is,
+  up to a phase factor,
+
+    X = (cos(w) s[n-1] - s[n-2]) + j sin(w) s[n-1]
+
+  The cost is one multiply per tone and sample, and the update
+  needs nothing but the new sample, so the work can be spread
+  over the sample interval instead of following the capture.
+  The poles stay exactly on the unit circle (the s[i-2] term is
+  not scaled), the twiddle only sets the tuning: cos(w) and
+  sin(w) come from fix_sin() of the linked fix_fft, with
+  its precision, and w is rounded to the N_WAVE steps of that
+  table.
+
+  goertzel_spectrum() scales X by 1/n, like fix_fft(), so the
+  result drops into the magnitude() stage in place of the FFT
+  bins.
+*/
+
+#include <stdint.h>
+#include "fix_fft.h"
+#include "goertzel.h"
+
+#define Q   (FFT_BITS-1)    /* fix_sin() is Q(FFT_BITS-1) */
+
+/* twiddle * state, a resonator near DC grows to ~n*128/sin(w) */
+#if FFT_BITS == 16
+typedef int64_t product;
+#else
+typedef int32_t product;
+#endif
+
+/*
+  goertzel_init() - tune g to hz at the sample rate, and map it to
+  the column of the n point FFT bin it falls in.
+*/
+void goertzel_init(goertzel_t *g, uint16_t hz, uint16_t rate, uint16_t n)
+{
+    uint16_t j;
+
+    /* 0 <= j < N_WAVE/2 for tones below Nyquist */
+    j = ((uint32_t)hz * N_WAVE + rate/2) / rate;
+    if (j >= N_WAVE/2)
+        j = N_WAVE/2 - 1;
+    g->cosw = fix_sin(j+N_WAVE/4);
+    g->sinw = fix_sin(j);
+    g->bin = ((uint32_t)hz * n + rate/2) / rate;
+    g->s1 = g->s2 = 0;
+}
+
+void goertzel_reset(goertzel_t g[], uint8_t tones)
+{
+    uint8_t t;
+
+    for (t=0; t<tones; ++t)
+        g[t].s1 = g[t].s2 = 0;
+}
+
+/*
+  goertzel_update() - feed one sample to every tone.
+*/
+void goertzel_update(goertzel_t g[], uint8_t tones, int8_t x)
+{
+    int32_t s;
+    uint8_t t;
+
+    for (t=0; t<tones; ++t) {
+        /* 2 cos(w) s1 in Q(FFT_BITS-1), one bit less shifted */
+        s = x + (((product)g[t].cosw * g[t].s1) >> (Q-1)) - g[t].s2;
+        g[t].s2 = g[t].s1;
+        g[t].s1 = s;
+    }
+}
+
+static int8_t clip8(int32_t v)
+{
+    if (v > 127)
+        return 127;
+    if (v < -128)
+        return -128;
+    return v;
+}
+
+/*
+  goertzel_spectrum() - the tones after 2**m samples as bins
+  re[]/im[] of a spectrum of bins columns, scaled by 2**-m like
+  fix_fft(); columns without a tone are 0. Tones sharing a column
+  keep the larger magnitude.
+*/
+void goertzel_spectrum(goertzel_t g[], uint8_t tones, int8_t re[], int8_t im[], uint8_t bins, int16_t m)
+{
+    int8_t xr, xi;
+    uint8_t t, k;
+
+    for (k=0; k<bins; ++k)
+        re[k] = im[k] = 0;
+
+    for (t=0; t<tones; ++t) {
+        k = g[t].bin;
+        if (k >= bins)
+            continue;
+        xr = clip8(((((product)g[t].cosw * g[t].s1) >> Q) - g[t].s2) >> m);
+        xi = clip8((((product)g[t].sinw * g[t].s1) >> Q) >> m);
+        /* each square fits an int, their sum only unsigned */
+        if ((uint16_t)(re[k]*re[k]) + (uint16_t)(im[k]*im[k])
+            > (uint16_t)(xr*xr) + (uint16_t)(xi*xi))
+            continue;
+        re[k] = xr;
+        im[k] = xi;
+    }
+}
@@ -0,0 +1,25 @@
+/* goertzel.h - Fixed-point Goertzel filters for a few tones */
+/*
+  Alternative to fix_fftr() when only a handful of frequencies
+  matter: one second order resonator per tone, updated once per
+  sample, see goertzel.c.
+*/
+
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+#include <stdint.h>
+#include "fix_fft.h"
+
+typedef struct {
+    fixed cosw, sinw;       /* twiddle of the tone, from fix_sin() */
+    int32_t s1, s2;         /* resonator state */
+    uint8_t bin;            /* display column */
+} goertzel_t;
+
+void goertzel_init(goertzel_t *g, uint16_t hz, uint16_t rate, uint16_t n);
+void goertzel_reset(goertzel_t g[], uint8_t tones);
+void goertzel_update(goertzel_t g[], uint8_t tones, int8_t x);
+void goertzel_spectrum(goertzel_t g[], uint8_t tones, int8_t re[], int8_t im[], uint8_t bins, int16_t m);
+
+#endif /* GOERTZEL_H */
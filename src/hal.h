@@ -0,0 +1,86 @@
+/******************************************************************************
+hal.h - hardware abstraction for the led_fft pipeline
+
+The spectrum pipeline in led_fft.c / spectrum.c never touches a peripheral
+register directly. Everything it needs from the board goes through the calls
+below, implemented by
+
+	hal_msp430.c	LaunchPad: ADC10 + DTC, Timer0_A, USCI_B0 SPI, P1/P2 buttons
+	hal_host.c	Linux: synthetic or file fed ADC, paced on a producer thread,
+			MAX7219 decoder as SPI sink, buttons from the
+			environment, BUSY_PIN profiling
+
+so the very same sample -> FFT -> render code can be profiled on a desktop.
+
+******************************************************************************/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+
+#define SMCLK_HZ	16000000UL			// timer / SPI clock
+
+// hal_switches() bits
+#define SW_MODE		0x01					// P1.3 tactile button, active while pressed
+#define SW_LSB		0x02					// P2.3 LSB/_USB switch
+#define SW_SPECTRUM	0x04					// P2.4 spectrum/_oscilloscope switch
+
+// hal_adc_reference() selection
+#define ADC_REF_VCC	0
+#define ADC_REF_INT	1
+
+#ifdef __MSP430__
+#include <msp430.h>
+#define hal_delay_cycles(n)	__delay_cycles(n)
+#else
+#define hal_delay_cycles(n)	((void)0)
+#endif
+
+// clocks, ports, SPI, ADC10 and timer setup; enables interrupts
+void hal_init(void);
+
+// main loop condition, also marks a frame boundary; always true on target
+uint8_t hal_running(void);
+
+//______________ ADC source
+void hal_adc_reference(uint8_t ref);
+// sample the input without end, one every period SMCLK ticks; block() gets
+// every few raw 0..1023 readings, called from the capture interrupt; called
+// again it changes the period
+void hal_capture_start(uint16_t period, void (*block)(const uint16_t raw[], uint8_t n));
+// hold off block(), so what it produced can be tested without a race
+void hal_capture_lock(void);
+void hal_capture_unlock(void);
+// sleep until block() ran at least once more; called locked, it unlocks and
+// sleeps in one step, so a block() in between still wakes it, and returns
+// unlocked
+void hal_capture_wait(void);
+
+//______________ SPI sink
+// one frame of len bytes, /CS low around it; waits for any stream below
+void hal_spi_write(const uint8_t *buf, uint8_t len);
+// clock frames out from the SPI interrupt and return at once: next() points
+// frame at the next one and returns its length, 0 when there is none left,
+// and is called from the interrupt as each frame is latched; called while a
+// stream runs it only keeps it running
+void hal_spi_stream(uint8_t (*next)(const uint8_t **frame));
+
+//______________ buttons
+uint8_t hal_switches(void);
+// wait for the mode button to be released, returns how long it was held, ms
+uint16_t hal_wait_release(void);
+
+//______________ timer driven test tone on TA0.1
+void hal_tone(uint16_t half_period);
+void hal_tone_output(uint8_t on);
+
+//______________ time
+// free running milliseconds, wraps at 2**16
+uint16_t hal_ms(void);
+
+//______________ status pins
+void hal_busy(uint8_t on);
+void hal_saturation(uint8_t on);
+
+#endif // HAL_H
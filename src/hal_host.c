@@ -0,0 +1,373 @@
+/******************************************************************************
+hal_host.c - Linux implementation of hal.h
+
+Runs the unmodified led_fft pipeline at desktop speed. Configured through the
+environment:
+
+	LED_FFT_INPUT	tone:HZ[:AMPL]		sine, default tone:1000
+			noise[:AMPL]		white noise
+			chirp:F0:F1[:AMPL]	linear sweep F0..F1 Hz once a second
+			file:PATH		whitespace separated 0..1023 ADC
+						readings, looped
+	LED_FFT_FRAMES	number of main loop passes, default 100
+	LED_FFT_DISPLAY	1 dumps every frame received by the MAX7219 chain
+	LED_FFT_LSB	1 sets the LSB/_USB switch
+	LED_FFT_SCOPE	1 selects the pseudo oscilloscope
+	LED_FFT_PRESS	comma separated frame numbers pressing the mode button,
+			FRAME:MS holds it MS ms (default 100, a short press)
+	LED_FFT_REALTIME 1 streams the samples at the sample rate from a
+			producer thread, as the ADC does; by default a block
+			is produced on demand in hal_capture_wait(), so runs
+			are fast and reproducible
+
+AMPL is in ADC counts around the 512 mid scale, default 400. On exit the
+number of frames, wall time, time spent with BUSY_PIN high (the FFT) and the
+bytes sent to the MAX7219 chain are reported on stderr.
+
+******************************************************************************/
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hal.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MAX_MODULES	16
+
+enum { SRC_TONE, SRC_NOISE, SRC_CHIRP, SRC_FILE };
+
+static struct {
+	int kind;
+	double f0, f1, ampl, phase, t;
+	FILE *file;
+} src;
+
+static double rate = 8000.0;
+static double t_sample;					// s of samples captured, hal_ms()
+static uint32_t frame, frames = 100;
+static uint8_t show, switches, realtime;
+static uint16_t mode_pressed;				// ms held, 0 when released
+static const char *press;
+
+// sample stream, blocks of CAPTURE_BLOCK as the DTC of hal_msp430.c
+#define CAPTURE_BLOCK	4
+
+static struct {
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	void (*block)(const uint16_t raw[], uint8_t n);
+	uint32_t blocks;
+} cap = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
+static uint8_t disp[MAX_MODULES][8];
+static uint8_t modules;
+
+static double t_start, t_busy, busy_since, t_wait;
+static uint32_t n_busy, spi_bytes;
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int env_flag(const char *name) {
+	const char *v = getenv(name);
+	return v && *v && *v != '0';
+}
+
+static uint32_t noise_state = 0x2545F491;
+
+static double noise(void) {
+	// xorshift32, reproducible across runs
+	noise_state ^= noise_state << 13;
+	noise_state ^= noise_state >> 17;
+	noise_state ^= noise_state << 5;
+	return (double)noise_state / 2147483648.0 - 1.0;
+}
+
+static void report(void) {
+	double wall = now() - t_start;
+	fprintf(stderr, "led_fft host: %u frames in %.3f ms, %.2f us/frame,"
+		" busy %.2f us/frame (%u busy periods), capture wait %.2f us/frame,"
+		" SPI %.1f bytes/frame\n",
+		frame, wall * 1e3, frame ? wall * 1e6 / frame : 0.0,
+		frame ? t_busy * 1e6 / frame : 0.0, n_busy,
+		frame ? t_wait * 1e6 / frame : 0.0,
+		frame ? (double)spi_bytes / frame : 0.0);
+}
+
+static void show_frame(void) {
+	int r, c;
+	printf("frame %u\n", frame);
+	for (r = 7; r >= 0; --r) {
+		for (c = 0; c < modules * 8; ++c)
+			putchar(disp[c >> 3][r] & (1 << (c & 7)) ? '#' : '.');
+		putchar('\n');
+	}
+}
+
+void hal_init(void) {
+	const char *in = getenv("LED_FFT_INPUT");
+	const char *v;
+
+	if (!in)
+		in = "tone:1000";
+	memset(&src, 0, sizeof(src));
+	src.ampl = 400;
+	if (!strncmp(in, "tone", 4)) {
+		src.kind = SRC_TONE;
+		src.f0 = 1000;
+		sscanf(in, "tone:%lf:%lf", &src.f0, &src.ampl);
+	} else if (!strncmp(in, "noise", 5)) {
+		src.kind = SRC_NOISE;
+		sscanf(in, "noise:%lf", &src.ampl);
+	} else if (!strncmp(in, "chirp", 5)) {
+		src.kind = SRC_CHIRP;
+		src.f1 = 4000;
+		sscanf(in, "chirp:%lf:%lf:%lf", &src.f0, &src.f1, &src.ampl);
+	} else if (!strncmp(in, "file:", 5)) {
+		src.kind = SRC_FILE;
+		src.file = fopen(in + 5, "r");
+		if (!src.file) {
+			perror(in + 5);
+			exit(1);
+		}
+	} else {
+		fprintf(stderr, "LED_FFT_INPUT: unknown source '%s'\n", in);
+		exit(1);
+	}
+
+	if ((v = getenv("LED_FFT_FRAMES")))
+		frames = strtoul(v, NULL, 0);
+	show = env_flag("LED_FFT_DISPLAY");
+	realtime = env_flag("LED_FFT_REALTIME");
+	press = getenv("LED_FFT_PRESS");
+
+	switches = SW_SPECTRUM;
+	if (env_flag("LED_FFT_LSB"))
+		switches |= SW_LSB;
+	if (env_flag("LED_FFT_SCOPE"))
+		switches &= ~SW_SPECTRUM;
+
+	t_start = now();
+	atexit(report);
+}
+
+// ms the mode button is held from this frame on, 0 if not pressed
+static uint16_t pressed(uint32_t f) {
+	const char *p = press;
+	unsigned long ms;
+	char *end;
+	while (p && *p) {
+		unsigned long n = strtoul(p, &end, 0);
+		if (end == p)
+			break;
+		ms = 100;
+		if (*end == ':')
+			ms = strtoul(end + 1, &end, 0);
+		if (n == f)
+			return ms ? (ms < 0xffff ? ms : 0xffff) : 1;
+		p = (*end == ',') ? end + 1 : end;
+	}
+	return 0;
+}
+
+uint8_t hal_running(void) {
+	if (frame && show)
+		show_frame();
+	if (frame >= frames)
+		return 0;
+	mode_pressed = pressed(frame++);
+	return 1;
+}
+
+void hal_adc_reference(uint8_t ref) {
+	(void)ref;
+}
+
+static uint16_t adc_sample(void) {
+	double x = 0, f;
+	int v;
+
+	switch (src.kind) {
+		case SRC_TONE:
+			x = src.ampl * sin(src.phase);
+			src.phase += 2 * M_PI * src.f0 / rate;
+			break;
+		case SRC_NOISE:
+			x = src.ampl * noise();
+			break;
+		case SRC_CHIRP:
+			f = src.f0 + (src.f1 - src.f0) * src.t;
+			x = src.ampl * sin(src.phase);
+			src.phase += 2 * M_PI * f / rate;
+			src.t += 1.0 / rate;
+			if (src.t >= 1.0)
+				src.t -= 1.0;
+			break;
+		case SRC_FILE:
+			if (fscanf(src.file, "%d", &v) != 1) {
+				rewind(src.file);
+				if (fscanf(src.file, "%d", &v) != 1)
+					v = 512;
+			}
+			return v < 0 ? 0 : v > 1023 ? 1023 : v;
+	}
+	if (src.phase > 2 * M_PI)
+		src.phase -= 2 * M_PI;
+
+	v = (int)lrint(512 + x);
+	return v < 0 ? 0 : v > 1023 ? 1023 : v;
+}
+
+// LED_FFT_REALTIME: the ADC interrupt, one block every CAPTURE_BLOCK sample periods
+static void *producer(void *arg) {
+	struct timespec due;
+	uint16_t raw[CAPTURE_BLOCK];
+	uint8_t i;
+
+	(void)arg;
+	clock_gettime(CLOCK_MONOTONIC, &due);
+	for (;;) {
+		for (i = 0; i < CAPTURE_BLOCK; ++i) {
+			raw[i] = adc_sample();
+			due.tv_nsec += (long)(1e9 / rate);
+			if (due.tv_nsec >= 1000000000L) {
+				due.tv_nsec -= 1000000000L;
+				++due.tv_sec;
+			}
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, NULL);
+		}
+
+		pthread_mutex_lock(&cap.lock);
+		cap.block(raw, CAPTURE_BLOCK);
+		t_sample += CAPTURE_BLOCK / rate;
+		++cap.blocks;
+		pthread_cond_broadcast(&cap.cond);
+		pthread_mutex_unlock(&cap.lock);
+	}
+	return NULL;
+}
+
+void hal_capture_start(uint16_t period, void (*block)(const uint16_t raw[], uint8_t n)) {
+	uint8_t running = cap.block != NULL;
+
+	// a restart only changes the period, the producer carries on
+	pthread_mutex_lock(&cap.lock);
+	rate = (double)SMCLK_HZ / period;
+	cap.block = block;
+	pthread_mutex_unlock(&cap.lock);
+	if (!running && realtime && pthread_create(&cap.thread, NULL, producer, NULL)) {
+		fprintf(stderr, "hal_capture_start: cannot start the ADC thread\n");
+		exit(1);
+	}
+}
+
+// the producer runs block() under cap.lock, as the ADC interrupt with GIE set
+void hal_capture_lock(void) {
+	pthread_mutex_lock(&cap.lock);
+}
+
+void hal_capture_unlock(void) {
+	pthread_mutex_unlock(&cap.lock);
+}
+
+void hal_capture_wait(void) {
+	uint16_t raw[CAPTURE_BLOCK];
+	double t0 = now();
+	uint32_t b;
+	uint8_t i;
+
+	if (!cap.block) {
+		fprintf(stderr, "hal_capture_wait: no capture started\n");
+		exit(1);
+	}
+	if (realtime) {
+		// unlocks and sleeps at once, like LPM0 + GIE
+		b = cap.blocks;
+		while (cap.blocks == b)
+			pthread_cond_wait(&cap.cond, &cap.lock);
+	} else {
+		for (i = 0; i < CAPTURE_BLOCK; ++i)
+			raw[i] = adc_sample();
+		cap.block(raw, CAPTURE_BLOCK);
+		t_sample += CAPTURE_BLOCK / rate;
+	}
+	pthread_mutex_unlock(&cap.lock);
+	t_wait += now() - t0;
+}
+
+void hal_spi_write(const uint8_t *buf, uint8_t len) {
+	uint8_t m;
+
+	// first pair clocked out lands in the last module, see max7219.c
+	spi_bytes += len;
+	modules = len / 2;
+	if (modules > MAX_MODULES)
+		modules = MAX_MODULES;
+	for (m = 0; m < modules; ++m) {
+		uint8_t reg = buf[2 * m];
+		if (reg >= 1 && reg <= 8)
+			disp[m][reg - 1] = buf[2 * m + 1];
+	}
+}
+
+// the interrupt of hal_msp430.c, run to the end at once
+void hal_spi_stream(uint8_t (*next)(const uint8_t **frame)) {
+	const uint8_t *f;
+	uint8_t len;
+
+	while ((len = next(&f)))
+		hal_spi_write(f, len);
+}
+
+uint8_t hal_switches(void) {
+	return switches | (mode_pressed ? SW_MODE : 0);
+}
+
+uint16_t hal_wait_release(void) {
+	uint16_t ms = mode_pressed;
+	mode_pressed = 0;
+	return ms;
+}
+
+// the time of the samples, not the wall clock, so runs are reproducible
+uint16_t hal_ms(void) {
+	uint16_t ms;
+
+	pthread_mutex_lock(&cap.lock);
+	ms = (uint16_t)(uint32_t)(t_sample * 1000);
+	pthread_mutex_unlock(&cap.lock);
+	return ms;
+}
+
+void hal_tone(uint16_t half_period) {
+	(void)half_period;
+}
+
+void hal_tone_output(uint8_t on) {
+	(void)on;
+}
+
+void hal_busy(uint8_t on) {
+	if (on) {
+		busy_since = now();
+	} else if (busy_since) {
+		t_busy += now() - busy_since;
+		busy_since = 0;
+		++n_busy;
+	}
+}
+
+void hal_saturation(uint8_t on) {
+	(void)on;
+}
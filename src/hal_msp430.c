@@ -0,0 +1,283 @@
+/******************************************************************************
+hal_msp430.c - MSP430G2553 LaunchPad implementation of hal.h
+
+	P1.4 <-- ADC4 audio input, sampled on TA0.2 and streamed by the DTC
+	P1.6 --> TA0.1 test tone
+	P1.5 --> SPI CLK, P1.7 --> SPI MOSI, P2.5 --> SPI /CS, sent from the
+		 USCI_B0 TX interrupt by hal_spi_stream()
+	P1.0 --> BUSY_PIN
+	P1.3 <-- mode button, P2.3 <-- LSB/_USB switch, P2.4 <-- spectrum/_scope
+
+******************************************************************************/
+
+#include <msp430.h>
+#include <stdint.h>
+#include "hal.h"
+
+#define LED_CS		BIT5					//2.5 is CS
+#define LED_DATA	BIT7					//1.7 is SPI MOSI
+#define LED_CLK		BIT5					//1.5 is SPI clock
+
+#define BUSY_PIN	BIT0					// P1.0 BUSY_PIN output
+
+volatile uint16_t play_at = 0;
+volatile uint16_t ticks=0;
+#define OVERFLOW_US	(65536UL * 1000000UL / SMCLK_HZ)	// TA0R wraps every 4096 us
+static volatile uint16_t ms;				// hal_ms()
+static uint16_t ms_us;					// us of ms still to count
+static uint16_t sample_half;				// TA0.2 toggles twice per sample
+#define CAPTURE_BLOCK	4					// samples per DTC block
+static uint16_t capture_buf[2 * CAPTURE_BLOCK];		// the DTC alternates between two blocks
+static void (*capture_block)(const uint16_t raw[], uint8_t n);
+static uint8_t (*spi_next)(const uint8_t **frame);	// frames for USCIAB0TX_ISR
+static const uint8_t *spi_frame;
+static uint8_t spi_left;					// bytes of spi_frame still to send
+
+//SPI initialization
+static void SPI_Init(void) {
+
+	P1SEL |= LED_DATA + LED_CLK;				// spi init
+	P1SEL2 |= LED_DATA + LED_CLK;				// spi init
+
+	UCB0CTL1 = UCSWRST;
+	UCB0CTL0 |= UCMSB + UCMST + UCSYNC + UCCKPH;		// 3-pin, 8-bit SPI master
+	UCB0CTL1 |= UCSSEL_2;					// SMCLK
+	UCB0BR0 = 2;						// spi speed is smclk/1 - 1MHz
+	UCB0BR1 = 0;						//
+	UCB0CTL1 &= ~UCSWRST;					// **Initialize USCI state machine**
+
+	P2DIR |= LED_CS;					//cs is output
+	P2SEL &= ~LED_CS;					//cs is not module
+	P2SEL2 &= ~LED_CS;					//cs is not module
+}
+
+void hal_init(void) {
+
+	WDTCTL = WDTPW + WDTHOLD;				// Stop WDT
+	BCSCTL1 = CALBC1_16MHZ;					// 16MHz clock
+	DCOCTL = CALDCO_16MHZ;
+
+	P1SEL = P2SEL = 0;
+	P1DIR = P2DIR = 0;
+	P1OUT = P2OUT = 0;
+
+	P1DIR |= BUSY_PIN;
+	P1OUT &= ~BUSY_PIN;
+
+	//______________ led port use
+	SPI_Init();
+	__delay_cycles(100000);
+
+	//______________ adc setting, use via microphone jumper on educational boost
+	ADC10CTL0 = SREF_0 + ADC10SHT_2 + REFON + ADC10ON + ADC10IE;
+//	ADC10CTL0 = SREF_0 + ADC10SHT_2 + ADC10ON + ADC10IE;
+	ADC10CTL1 = INCH_4;					// input A4
+	ADC10AE0 |= BIT4;					// P1.4 ADC microphone
+
+	P1OUT |= BIT3;						// tactile button pull-up
+	P1REN |= BIT3;
+
+	P2OUT |= BIT3 | BIT4;
+	P2REN |= BIT3 | BIT4;
+
+	//______________ setup test tone signal via TA0.1
+	TA0CCR0 = TA0CCR1 = 0;
+
+	TA0CTL = TASSEL_2 + MC_2 + TAIE;			// smclk, continous mode
+	TA0CCTL1 = OUTMOD_4 + CCIE;				// we want pin-toggle, 2 times slower
+	TA0CCR1 = play_at;
+	P1DIR |= BIT6;						// prepare both T0.1
+	_BIS_SR(GIE); 						// now
+}
+
+uint8_t hal_running(void) {
+	return 1;
+}
+
+void hal_adc_reference(uint8_t ref) {
+	ADC10CTL0 &= ~ENC;
+	ADC10CTL0 &= ~(SREF0 | SREF1 | SREF2);
+	ADC10CTL0 |= (ref == ADC_REF_INT ? SREF_1 : SREF_0) | ENC;
+}
+
+/*
+  Every rising edge of TA0.2 starts a conversion (SHS_3, repeat single
+  channel) and the DTC moves the result into capture_buf[], no CPU
+  involved but the CCR2 update in Timer0_A1_iSR. In two-block
+  continuous mode ADC10_ISR hands each full block of CAPTURE_BLOCK
+  samples to block() while the DTC fills the other one, so block() has
+  CAPTURE_BLOCK sample periods to finish.
+*/
+void hal_capture_start(uint16_t period, void (*block)(const uint16_t raw[], uint8_t n)) {
+	// time delay between adc samples
+	// this will become the band frequency after time - frequency conversion
+	sample_half = (period + 1) >> 1;
+	capture_block = block;
+
+	ADC10CTL0 &= ~ENC;
+	while (ADC10CTL1 & ADC10BUSY);				// let a conversion in flight finish
+	ADC10CTL1 = INCH_4 + SHS_3 + CONSEQ_2;			// input A4, TA0.2 triggered, repeated
+	ADC10DTC0 = ADC10TB + ADC10CT;				// two blocks, wrap around
+	ADC10DTC1 = CAPTURE_BLOCK;				// DTC1 first, writing SA arms the DTC
+	ADC10SA = (uint16_t)(uintptr_t)capture_buf;
+
+	TA0CCR2 = TA0R + sample_half;
+	TA0CCTL2 = OUTMOD_4 + CCIE;				// toggle, conversion on every other edge
+	ADC10CTL0 |= ENC;
+}
+
+void hal_capture_lock(void) {
+	__disable_interrupt();
+}
+
+void hal_capture_unlock(void) {
+	__enable_interrupt();
+}
+
+void hal_capture_wait(void) {
+	// GIE and LPM0 in one instruction: an ADC10_ISR pending since the lock
+	// runs right after it and wakes us, none can slip in before the sleep
+	__bis_SR_register(LPM0_bits | GIE);			// wake me up with the next block
+}
+
+void hal_spi_write(const uint8_t *buf, uint8_t len) {
+	while (IE2 & UCB0TXIE);					// a stream is still going out
+	P2OUT &= ~LED_CS;
+	__delay_cycles(50);
+	while(len) {
+		UCB0TXBUF = *buf;
+		while (UCB0STAT & UCBUSY);
+		++buf; --len;
+	}
+	P2OUT |= LED_CS;
+}
+
+/*
+  UCB0TXIFG is set whenever UCB0TXBUF is free, so USCIAB0TX_ISR runs
+  once per byte for as long as UCB0TXIE is on. At the end of a frame it
+  waits for the last byte to leave the shift register, a byte is 16
+  cycles at SMCLK/2, and raises /CS, which latches the frame into the
+  MAX7219 chain. It then asks next() for the following frame and turns
+  UCB0TXIE off when there is none.
+*/
+void hal_spi_stream(uint8_t (*next)(const uint8_t **frame)) {
+	spi_next = next;
+	IE2 |= UCB0TXIE;					// UCB0TXIFG pending, starts at once
+}
+
+uint8_t hal_switches(void) {
+	uint8_t sw = 0;
+	if (!(P1IN&BIT3))
+		sw |= SW_MODE;
+	if (P2IN&BIT3)
+		sw |= SW_LSB;
+	if (P2IN&BIT4)
+		sw |= SW_SPECTRUM;
+	return sw;
+}
+
+uint16_t hal_wait_release(void) {
+	uint16_t held = 0;
+	while (!(P1IN&BIT3)) {
+		__delay_cycles(SMCLK_HZ/1000);			// MCLK = SMCLK
+		if (held < 0xffff)
+			held++;
+	}
+	return held;
+}
+
+uint16_t hal_ms(void) {
+	return ms;						// in 4 ms steps
+}
+
+void hal_tone(uint16_t half_period) {
+	play_at = half_period;
+}
+
+void hal_tone_output(uint8_t on) {
+	if (on)
+		P1SEL |= BIT6;					// pin toggle on
+	else
+		P1SEL &= ~BIT6;
+}
+
+void hal_busy(uint8_t on) {
+	if (on)
+		P1OUT |= BUSY_PIN;
+	else
+		P1OUT &= ~BUSY_PIN;
+}
+
+void hal_saturation(uint8_t on) {
+	hal_busy(on);
+}
+
+// ADC10 interrupt service routine
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=ADC10_VECTOR
+__interrupt void ADC10_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(ADC10_VECTOR))) ADC10_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+	// ADC10B1: block 1 is full and the DTC moved on to block 2
+	if (ADC10DTC0 & ADC10B1)
+		capture_block(capture_buf, CAPTURE_BLOCK);
+	else
+		capture_block(capture_buf + CAPTURE_BLOCK, CAPTURE_BLOCK);
+	__bic_SR_register_on_exit(CPUOFF);
+}
+
+// USCI_B0 SPI transmit interrupt service routine, UCA0 is not used
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=USCIAB0TX_VECTOR
+__interrupt void USCIAB0TX_ISR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(USCIAB0TX_VECTOR))) USCIAB0TX_ISR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+	if (!spi_left) {
+		while (UCB0STAT & UCBUSY);			// last frame shifted out
+		P2OUT |= LED_CS;				// and latched
+		spi_left = spi_next(&spi_frame);
+		if (!spi_left) {
+			IE2 &= ~UCB0TXIE;
+			return;
+		}
+		P2OUT &= ~LED_CS;
+	}
+	UCB0TXBUF = *spi_frame++;
+	--spi_left;
+}
+
+//________________________________________________________________________________
+//interrupt(TIMERA1_VECTOR) Timer_A1(void) {
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=TIMER0_A1_VECTOR
+__interrupt void Timer0_A1_iSR(void)
+#elif defined(__GNUC__)
+void __attribute__ ((interrupt(TIMER0_A1_VECTOR))) Timer0_A1_iSR (void)
+#else
+#error Compiler not supported!
+#endif
+{
+	switch(TAIV) {
+		case TA0IV_TACCR1:
+			CCR1 += play_at;
+			break;
+		case TA0IV_TACCR2:
+			TA0CCR2 += sample_half;
+			break;
+		case TA0IV_TAIFG:
+			if (ticks)
+				ticks--;
+			for (ms_us += OVERFLOW_US; ms_us >= 1000; ms_us -= 1000)
+				++ms;
+			break;
+	}//switch
+}
+//
@@ -0,0 +1,112 @@
+/******************************************************************************
+max7219.c - display packing for DISPLAY_MODULES chained MAX7219 modules
+
+Every SPI frame carries one (register, value) pair per module, the first pair
+clocked out ends up in the last module of the chain. Pair m carries the digit
+register of row i+1 with columns 8m..8m+7; with DISPLAY_FLIP pair m carries
+module DISPLAY_MODULES-1-m bit reversed into register 8-i instead.
+
+update_display() only sends what changed since the last call: rows equal to
+the one shown are skipped, and modules whose byte of a changed row is the same
+get an OP_NOOP pair, so they keep their digit register. The changed bytes are
+copied to shown[] and marked in pending[], next_frame() turns them into
+frames from the SPI interrupt, so update_display() returns before they are
+sent and the next frame is captured and transformed meanwhile.
+
+******************************************************************************/
+
+#include <stdint.h>
+#include "hal.h"
+#include "max7219.h"
+
+display_t dbuff;
+
+#if DISPLAY_MODULES > 8
+typedef uint16_t modules_t;				// a bit per module
+#else
+typedef uint8_t modules_t;
+#endif
+
+static uint8_t spibuff[2 * DISPLAY_MODULES];		// frame next_frame() hands out
+static display_t shown;					// as sent or about to be sent
+static volatile modules_t pending[8];			// per row, modules to send shown[] to
+static uint8_t stale;					// chain contents unknown, send all
+
+void Init_MAX7219(void) {
+
+	uint8_t config_reg[5] = { OP_DECODEMODE, OP_INTENSITY, OP_SCANLIMIT, OP_SHUTDOWN, OP_DISPLAYTEST };
+	uint8_t config_val[5] = {          0x00,         0x00,         0x07,        0x01,           0x00 };
+
+	uint8_t config[2 * DISPLAY_MODULES];			// spibuff may be going out
+	uint8_t g,h;
+
+	for(h = 0; h < sizeof(config_reg); ++h) {
+		for(g = 0; g < DISPLAY_MODULES; ++g) {
+			config[ (g << 1)     ] = config_reg[h];
+			config[ (g << 1) + 1 ] = config_val[h];
+		}
+		hal_spi_write(config, sizeof(config));
+	};
+	stale = 1;
+}
+
+#ifdef DISPLAY_FLIP
+static uint8_t reverse(uint8_t b) {
+	static const uint8_t nibble[16] = { 0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+					    0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF };
+	return (nibble[b & 0x0F] << 4) | nibble[b >> 4];
+}
+#define PAIR(g)		((DISPLAY_MODULES - 1 - (g)) << 1)
+#define DIGIT(i)	(8 - (i))
+#define BITS(b)		reverse(b)
+#else
+#define PAIR(g)		((g) << 1)
+#define DIGIT(i)	((i) + 1)
+#define BITS(b)		(b)
+#endif // DISPLAY_FLIP
+
+/*
+  The first row with pending modules as an SPI frame, from the SPI
+  interrupt. update_display() may add modules meanwhile, at worst a
+  module is sent twice.
+*/
+static uint8_t next_frame(const uint8_t **frame) {
+	uint8_t i, g;
+	for(i = 0; i < 8 && !pending[i]; ++i);
+	if (i == 8)
+		return 0;
+	for(g = 0; g < DISPLAY_MODULES; ++g) {
+		if (pending[i] & ((modules_t)1 << g)) {
+			spibuff[ PAIR(g)     ] = DIGIT(i);
+			spibuff[ PAIR(g) + 1 ] = BITS(shown.rows[i][g]);
+		} else {
+			spibuff[ PAIR(g)     ] = OP_NOOP;
+			spibuff[ PAIR(g) + 1 ] = 0;
+		}
+	}
+	pending[i] = 0;
+	*frame = spibuff;
+	return sizeof(spibuff);
+}
+
+// a frame per changed row, all modules of the chain at once
+void update_display(void) {
+	uint8_t i, g, changed = 0;
+	modules_t dirty;
+	for(i = 0; i < 8; ++i) {
+		dirty = 0;
+		for(g = 0; g < DISPLAY_MODULES; ++g) {
+			if (stale || dbuff.rows[i][g] != shown.rows[i][g]) {
+				shown.rows[i][g] = dbuff.rows[i][g];
+				dirty |= (modules_t)1 << g;
+			}
+		}
+		if (dirty) {
+			pending[i] |= dirty;
+			changed = 1;
+		}
+	}
+	stale = 0;
+	if (changed)
+		hal_spi_stream(next_frame);
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+max7219.h - DISPLAY_MODULES daisy chained MAX7219 8x8 modules, 8 rows x
+DISPLAY_COLUMNS columns
+
+dbuff.rows[row][m] holds columns 8m..8m+7 of one display row, bit n lights
+column 8m+n; DISPLAY_SET() / DISPLAY_CLEAR() address a column directly.
+update_display() queues the rows and modules that changed since the last call
+and returns, they go out from the SPI interrupt; Init_MAX7219() makes the next
+one send them all.
+
+******************************************************************************/
+
+#ifndef MAX7219_H
+#define MAX7219_H
+
+#include <stdint.h>
+
+// 8x8 modules in the chain, a power of 2: 4 for 32 columns, 8 for 64, 16 for 128
+#ifndef DISPLAY_MODULES
+#define DISPLAY_MODULES	4
+#endif
+#define DISPLAY_COLUMNS	(8 * DISPLAY_MODULES)
+// modules mounted upside down: rows, columns and the chain order reversed
+//#define DISPLAY_FLIP
+
+#if DISPLAY_MODULES < 1 || DISPLAY_MODULES > 16 || (DISPLAY_MODULES & (DISPLAY_MODULES - 1))
+#error DISPLAY_MODULES must be a power of 2 up to 16
+#endif
+
+#define OP_NOOP 0x00
+#define OP_DECODEMODE 0x09
+#define OP_INTENSITY 0x0A
+#define OP_SCANLIMIT 0x0B
+#define OP_SHUTDOWN 0x0C
+#define OP_DISPLAYTEST 0x0F
+
+typedef struct {
+	uint8_t rows[8][DISPLAY_MODULES];
+} display_t;
+
+#define DISPLAY_BIT(col)	(1 << ((col) & 7))
+#define DISPLAY_SET(row, col)	(dbuff.rows[row][(col) >> 3] |= DISPLAY_BIT(col))
+#define DISPLAY_CLEAR(row, col)	(dbuff.rows[row][(col) >> 3] &= ~DISPLAY_BIT(col))
+
+extern display_t dbuff;
+
+void Init_MAX7219(void);
+void update_display(void);
+
+#endif // MAX7219_H
@@ -0,0 +1,487 @@
+/******************************************************************************
+spectrum.c - acquisition, conditioning, magnitude, smoothing and render stages
+
+Split out of main() so the exact production code path can be built against
+either hal_msp430.c or hal_host.c.
+
+******************************************************************************/
+
+#include <stdint.h>
+#include "hal.h"
+#include "max7219.h"
+#include "spectrum.h"
+#include "spectrum_tables.h"
+
+/*
+  squared magnitude thresholds of display rows 1..8, so a bin lights
+  row k once re*re + im*im >= level_sq[map][k-1]
+*/
+#define SQ(a)	((uint16_t)(a)*(a))
+static const uint16_t level_sq[LEVEL_DB][8] = {
+	// LEVEL_LINEAR: a row per unit of magnitude
+	{ SQ(1), SQ(2), SQ(3), SQ(4), SQ(5), SQ(6), SQ(7), SQ(8) },
+	// LEVEL_TONE: a row per 8, half a row offset, for the test tone
+	{ SQ(4), SQ(12), SQ(20), SQ(28), SQ(36), SQ(44), SQ(52), SQ(60) },
+	// LEVEL_LOG: 6dB per row, magnitude 1..128
+	{ SQ(1), SQ(2), SQ(4), SQ(8), SQ(16), SQ(32), SQ(64), SQ(128) },
+};
+
+/*
+  LEVEL_DB: row k lights at DB_FLOOR + (k-1)*DB_RANGE/8 dBFS, as
+  log2(re*re + im*im) in Q8; 0 dBFS is magnitude 128 (log2 = 14)
+*/
+#define DB_ROW(k)	((int16_t)(14*256 + (DB_FLOOR + ((k)-1)*DB_RANGE/8.0) * 256/3.0103 + 0.5))
+static const int16_t level_db[8] = {
+	DB_ROW(1), DB_ROW(2), DB_ROW(3), DB_ROW(4), DB_ROW(5), DB_ROW(6), DB_ROW(7), DB_ROW(8)
+};
+
+/*
+  log2 of x > 0 in Q8: the leading one gives the integer part, the
+  4 bits below it the fraction from log2_mant[] of spectrum_tables.h,
+  within 0.045 octave (0.14dB of power)
+*/
+static int16_t log2_q8(uint16_t x) {
+	int16_t e = 15;
+	// count leading zeros
+	if (!(x & 0xff00)) { x <<= 8; e -= 8; }
+	if (!(x & 0xf000)) { x <<= 4; e -= 4; }
+	if (!(x & 0xc000)) { x <<= 2; e -= 2; }
+	if (!(x & 0x8000)) { x <<= 1; e -= 1; }
+	return (e << 8) + log2_mant[(x >> 11) & 0x0f];
+}
+
+/*
+  Sample conditioning runs in the capture interrupt as the samples
+  arrive: a running DC estimate is removed, the rest shifted right by
+  the AGC gain, clipped and kept as int8 in the ring of the last Nx,
+  at the start of arena[]. HOP samples are taken per frame, further
+  ones are dropped until acquire() has copied the frame, so the ring
+  never changes under it; in place, until the next acquire(). A drop
+  leaves a gap after the ring, so the frame after it waits for Nx new
+  samples instead of a HOP: no overlap, but contiguous in time.
+*/
+static int8_t arena[ARENA];
+static uint8_t hop_shift[HOPS];				// gain shift of each HOP of the ring
+static volatile uint16_t written, taken;		// sample counts, mod 2**16
+static volatile uint16_t hop;				// 0 while capture() sets up
+static uint16_t nx_mask;				// Nx - 1
+static uint8_t hop_log2, log2nx, in_place, held;
+static volatile uint8_t dropped;			// samples lost since the frame
+static volatile uint8_t gain_shift = GAIN_SHIFT;
+static volatile uint16_t peak;				// of |sample - DC| since the last frame
+#ifdef SATURATION
+static volatile uint8_t saturated;
+#endif // SATURATION
+static int16_t dc = 512 << DC_Q;			// DC estimate, Q(DC_Q) ADC counts
+
+static void arrive(const uint16_t raw[], uint8_t n) {
+	int16_t s;
+	uint8_t i;
+
+	for (i=0;i<n;i++) {
+		if ((int16_t)(written - taken) >= (int16_t)hop) {
+			dropped = hop != 0;			// frame complete, acquire() is late
+			return;
+		}
+
+#ifdef SATURATION
+		if((raw[i] > (1023 - SATURATION)) || (raw[i] < SATURATION))
+			saturated = 1;
+#endif // SATURATION
+
+		// one pole low pass, time constant 2**DC_LOG2 samples
+		dc += ((int16_t)(raw[i] << DC_Q) - dc) >> DC_LOG2;
+		s = raw[i] - ((dc + (1 << (DC_Q - 1))) >> DC_Q);
+		if ((uint16_t)(s < 0 ? -s : s) > peak)
+			peak = s < 0 ? -s : s;
+
+		// the gain only changes between HOPs
+		if (!(written & (hop - 1)))
+			hop_shift[(written & nx_mask) >> hop_log2] = gain_shift;
+		s >>= gain_shift;
+		// clip, do not wrap, when the gain is too high
+		if (s > 127)
+			s = 127;
+		else if (s < -128)
+			s = -128;
+		arena[written & nx_mask] = s;
+		written++;
+	}
+}
+
+// least attenuation that keeps the peak envelope within AGC_TARGET
+static uint8_t agc(uint16_t level) {
+#ifdef AGC
+	static uint16_t envelope = 0;
+	uint8_t shift = 0;
+	if (level > envelope)
+		envelope += (level - envelope + (1 << AGC_ATTACK) - 1) >> AGC_ATTACK;
+	else
+		envelope -= (envelope - level) >> AGC_RELEASE;
+	while (shift < 3 && (envelope >> shift) > AGC_TARGET)
+		shift++;
+	return shift;
+#else
+	(void)level;
+	return GAIN_SHIFT;
+#endif // AGC
+}
+
+int8_t *capture(uint8_t log2n, uint16_t period) {
+	uint16_t i;
+
+	hop = 0;						// arrive() drops all until set up
+	nx_mask = (1 << log2n) - 1;
+	log2nx = log2n;
+	// no room for a separate frame: in place and without overlap
+	in_place = 2 << log2n > ARENA;
+	hop_log2 = log2n;
+	for (i=HOPS;i>1 && !in_place;i>>=1)
+		hop_log2--;
+	for (i=0;i<ARENA;i++)
+		arena[i] = 0;
+	for (i=0;i<HOPS;i++)
+		hop_shift[i] = gain_shift;
+	written = taken = 0;
+	held = dropped = 0;
+	hop = 1 << hop_log2;
+	hal_capture_start(period, arrive);
+	return in_place ? arena : arena + (1 << log2n);
+}
+
+uint8_t acquire(int8_t data[], int16_t *offset, uint8_t window) {
+	int8_t s;
+	uint16_t i, j;
+	uint8_t shift = 0;
+
+	// in place the last frame kept the ring, the capture goes on from here
+	if (held) {
+		held = 0;
+		taken += hop;
+	}
+	// tested locked, a HOP completing before the sleep must still wake it
+	for (;;) {
+		hal_capture_lock();
+		if ((int16_t)(written - taken) >= (int16_t)hop)
+			break;
+		hal_capture_wait();
+	}
+	hal_capture_unlock();
+	// arrive() holds off until taken moves on
+
+#ifdef SATURATION
+	// turn on LED if saturation detected
+	hal_saturation(saturated);
+	saturated = 0;
+#endif // SATURATION
+
+	// HOPs taken at a higher gain are brought down to the lowest one
+	for (i=0;i<=(nx_mask >> hop_log2);i++)
+		if (hop_shift[i] > shift)
+			shift = hop_shift[i];
+
+#ifndef WINDOWING
+	(void)window;
+#endif
+	// oldest sample first, it is the one HOP after taken; in place the
+	// frame starts at the ring's start, data[i] only depends on ring[i]
+	j = taken + hop;
+	for (i=0;i<=nx_mask;i++,j++) {
+		s = arena[j & nx_mask] >> (shift - hop_shift[(j & nx_mask) >> hop_log2]);
+#ifdef WINDOWING
+		if (window)
+			s = (WINDOW_HALF(log2nx)[i <= nx_mask/2 ? i : nx_mask - i] * s) >> 8;
+#endif // WINDOWING
+		data[i] = s;
+	}
+
+	*offset = ((dc + (1 << (DC_Q - 1))) >> DC_Q) - 512 + 8;	// signal leveling?
+	gain_shift = agc(peak);
+	peak = 0;
+	if (in_place)
+		held = 1;
+	else {
+		// after a gap the ring is started afresh, taken runs up to Nx
+		// ahead of written until then
+		hal_capture_lock();
+		taken += dropped ? nx_mask + 1 : hop;
+		dropped = 0;
+		hal_capture_unlock();
+	}
+	return shift;
+}
+
+void magnitude(int8_t data[], const int8_t im[], uint8_t n, uint8_t map, int8_t exponent) {
+	const uint16_t *ts = level_sq[map < LEVEL_DB ? map : 0];
+	uint16_t t[8], m2;
+	int16_t l2;
+	uint8_t i, k, a;
+	// scale the thresholds by 4**exponent instead of the bins, and by the
+	// window's power loss; beyond the largest m2 (2*128*128) a row is never lit
+	for (k=0;k<8;k++) {
+#ifdef WINDOWING
+		t[k] = ((uint32_t)ts[k] * WINDOW_CG2(log2nx) + 0x8000) >> 16;
+#else
+		t[k] = ts[k];
+#endif // WINDOWING
+		// no shift of 16 or more, it is undefined on a 16-bit int
+		if (exponent < 0)
+			t[k] = -2*exponent >= 16 ? 0 : t[k] >> -2*exponent;
+		else if (2*exponent >= 16 || t[k] > (0xffffU >> (2*exponent)))
+			t[k] = 0xffff;
+		else
+			t[k] <<= 2*exponent;
+		// an empty bin never lights a row
+		if (!t[k])
+			t[k] = 1;
+	}
+	for (i=0;i<n;i++) {
+		// each square fits an int, their sum (up to 2*128*128) only unsigned
+		m2 = (uint16_t)(data[i]*data[i]) + (uint16_t)(im[i]*im[i]);
+		// rows lit = thresholds reached, no square root, no search
+		a = 0;
+		if (map == LEVEL_DB) {
+			if (m2) {
+				l2 = log2_q8(m2) - (exponent << 9);
+#ifdef WINDOWING
+				l2 += 2 * WINDOW_CG_LOG2(log2nx);
+#endif // WINDOWING
+				for (k=0;k<8;k++)
+					a += l2 >= level_db[k];
+			}
+		} else {
+			for (k=0;k<8;k++)
+				a += m2 >= t[k];
+		}
+		data[i] = a;
+	}//for
+}
+
+void columns(int8_t level[], uint8_t n) {
+	uint8_t i, j, k, b;
+	int8_t a;
+
+	if (n > COLUMNS) {
+		// peak detector, a narrow tone keeps its height
+		k = n / COLUMNS;
+		for (i=0,b=0;i<COLUMNS;i++) {
+			a = level[b++];
+			for (j=1;j<k;j++,b++)
+				if (level[b] > a)
+					a = level[b];
+			level[i] = a;
+		}
+	} else {
+		// from the top down, a bin is read before its columns cover it
+		k = COLUMNS / n;
+		for (i=COLUMNS,b=n;b--;)
+			for (j=0;j<k;j++)
+				level[--i] = level[b];
+	}
+}
+
+/*
+  Bars and peak dots move by the time since the last frame, so they look
+  the same at every FFT size, band and HOPS.
+
+  dots[] packs the row of a peak dot, low nibble, with the ticks of
+  PEAK_TICK_MS it has left before falling a row, high nibble. A bar
+  reaching the dot lifts it and holds it PEAK_HOLD_MS, then it falls a
+  row every PEAK_FALL_MS down to the bottom row.
+
+  bars[] is a bar in Q4 rows for SMOOTH_*_MS, moved by dt/(tau+dt) of
+  the way to the new level, the fixed point 1-exp(-dt/tau) of the
+  exponential attack or release, and at least 1/16 row so it settles.
+  For AVERAGE_LOG2 it is the mean square of the bar in Q2 instead,
+  moved by 1/2**AVERAGE_LOG2 of the way per frame, and the bar is its
+  root.
+*/
+#ifdef DOTS
+#define PEAK_HOLD	(PEAK_HOLD_MS / PEAK_TICK_MS)
+#define PEAK_FALL	(PEAK_FALL_MS / PEAK_TICK_MS)
+static uint8_t dots[COLUMNS];
+static uint16_t dots_ms;				// not yet counted in ticks
+#endif // DOTS
+#if defined(SMOOTH_RELEASE_MS) || defined(AVERAGE_LOG2)
+static uint8_t bars[COLUMNS];
+#endif
+static uint16_t smooth_at;				// hal_ms() of the last smooth()
+
+#ifdef SMOOTH_RELEASE_MS
+#ifndef SMOOTH_ATTACK_MS
+#define SMOOTH_ATTACK_MS	0
+#endif
+// dt/(tau+dt) in Q8, 255 for all of it
+static uint8_t share(uint16_t dt, uint16_t tau) {
+	uint32_t q = ((uint32_t)dt << 8) / ((uint32_t)tau + dt + !(tau|dt));
+	return q > 255 ? 255 : q;
+}
+#endif // SMOOTH_RELEASE_MS
+
+#ifdef AVERAGE_LOG2
+// mean square in Q2 of the middle between rows k and k+1, (2k+1)**2
+static const uint8_t rms_row[8] = { 1, 9, 25, 49, 81, 121, 169, 225 };
+#endif // AVERAGE_LOG2
+
+void smooth(int8_t level[], uint8_t n) {
+	uint16_t now = hal_ms(), dt = now - smooth_at;
+	uint8_t i;
+#ifdef SMOOTH_RELEASE_MS
+	uint8_t up = share(dt, SMOOTH_ATTACK_MS), down = share(dt, SMOOTH_RELEASE_MS);
+	int16_t d, step;
+#endif
+#ifdef AVERAGE_LOG2
+	int16_t d;
+	uint8_t r;
+#endif
+#ifdef DOTS
+	uint8_t ticks = 0, t, row, e;
+
+	dots_ms += dt;
+	if (dots_ms > 255 * PEAK_TICK_MS)
+		dots_ms = 255 * PEAK_TICK_MS;
+	for (;dots_ms >= PEAK_TICK_MS;dots_ms -= PEAK_TICK_MS)
+		++ticks;
+#endif // DOTS
+	smooth_at = now;
+
+	for (i=0;i<n;i++) {
+#ifdef SMOOTH_RELEASE_MS
+		d = (level[i] << 4) - bars[i];
+		step = (d * (d > 0 ? up : down)) >> 8;
+		if (!step)
+			step = d > 0 ? 1 : d < 0 ? -1 : 0;
+		bars[i] += step;
+		level[i] = (bars[i] + 8) >> 4;
+#endif // SMOOTH_RELEASE_MS
+#ifdef AVERAGE_LOG2
+		d = level[i] * level[i] << 2;
+		d = (d > 255 ? 255 : d) - bars[i];
+		// rounded away from bars[], so it reaches a steady level
+		bars[i] += d > 0 ? (d + (1 << AVERAGE_LOG2) - 1) >> AVERAGE_LOG2 : d >> AVERAGE_LOG2;
+		for (r=0;r<8 && bars[i] >= rms_row[r];r++);
+		level[i] = r;
+#endif // AVERAGE_LOG2
+#ifdef DOTS
+		row = dots[i] & 0x0F;
+		t = dots[i] >> 4;
+		if (level[i] && level[i] >= row) {
+			row = level[i];
+			t = PEAK_HOLD;
+		} else {
+			// spend the ticks: the rest of the hold, then PEAK_FALL per row
+			for (e=ticks;e && row;) {
+				if (t > e) {
+					t -= e;
+					break;
+				}
+				e -= t;
+				t = PEAK_FALL;
+				--row;
+			}
+			if (!row)
+				t = 0;
+		}
+		dots[i] = (t << 4) | row;
+#endif // DOTS
+	}//for
+}
+
+void smooth_reset(void) {
+	uint8_t i;
+	for (i=0;i<COLUMNS;i++) {
+#ifdef DOTS
+		dots[i] = 0;
+#endif
+#if defined(SMOOTH_RELEASE_MS) || defined(AVERAGE_LOG2)
+		bars[i] = 0;
+#endif
+	}
+	smooth_at = hal_ms();
+}
+
+/*
+  The renderers build one module at a time: a byte per column, bit r
+  lighting row r, looked up from the bar height or the dot row, then
+  transposed into the 8 row bytes of the module. No per-pixel tests, and
+  the rows above the highest lit one are cleared at once.
+*/
+static const uint8_t bar_rows[9] = { 0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF };
+// a dot of 8, a peak above the top row, stays dark
+static const uint8_t dot_row[9] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 };
+
+// col[k], column 8m+k, into dbuff.rows[][m]; col[] is used up
+static void transpose(uint8_t col[8], uint8_t m) {
+	uint8_t r, k, row, lit = 0;
+	for (k=0;k<8;k++)
+		lit |= col[k];
+	for (r=0;lit;r++,lit>>=1) {
+		row = 0;
+		for (k=8;k--;) {
+			row = (row << 1) | (col[k] & 1);
+			col[k] >>= 1;
+		}
+		dbuff.rows[r][m] = row;
+	}
+	for (;r<8;r++)
+		dbuff.rows[r][m] = 0;
+}
+
+void render_bars(const int8_t level[], uint8_t n, uint8_t lsb) {
+	uint8_t col[8];
+	uint8_t m, k, i;
+	// LSB: column 0 on the right, walk the levels backwards
+	int8_t step = lsb ? -1 : 1;
+	for(m = 0; m < n/8; ++m) {
+		i = lsb ? n - 1 - 8*m : 8*m;
+		for(k = 0; k < 8; ++k, i += step) {
+#ifdef FILL
+			col[k] = bar_rows[(uint8_t)level[i]];
+#else
+			col[k] = 0;
+#endif
+#ifdef DOTS
+			col[k] |= dot_row[dots[i] & 0x0F];
+#endif
+		}
+		transpose(col, m);
+	}//for
+}
+
+void render_scope(int8_t data[], uint16_t n, uint8_t gen_tone, int16_t offset) {
+	uint16_t i;
+	uint8_t c, r, col[8];
+	// samples per column, or columns per sample when there are fewer
+	uint8_t step = n >= COLUMNS ? n / COLUMNS : 1;
+	uint8_t rep = n >= COLUMNS ? 1 : COLUMNS / n;
+
+#define LEVELING
+#ifdef LEVELING
+	// signal leveling
+	switch (gen_tone) {
+		case 1:
+			for (i=0;i<n;i++)
+				data[i] -= 128;
+		break;
+		case 2:
+			for (i=0;i<n;i++)
+				data[i] -= offset >> LOG2N_DEFAULT;
+		break;
+	}//switch
+#endif //def LEVELING
+
+	// the last of every step samples in a column
+	for (c=0,r=0,i=step-1;c<COLUMNS;c++) {
+		col[c & 7] = dot_row[0x07 & ((data[i]
+#ifdef LEVELING
+						 + ((gen_tone == 1)?128:0)
+#endif //def LEVELING
+							) >> 5)];	// row <2^3> of data <2^8>
+		if ((c & 7) == 7)
+			transpose(col, c >> 3);
+		if (++r == rep) {
+			r = 0;
+			i += step;
+		}
+	}//for
+}
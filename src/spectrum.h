@@ -0,0 +1,180 @@
+/******************************************************************************
+spectrum.h - sample -> FFT -> render stages of the led_fft main loop
+
+******************************************************************************/
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdint.h>
+#include "hal.h"
+#include "max7219.h"
+
+#define SATURATION 16
+#define DOTS						// peak dots over the bars
+#define FILL 1
+// a peak dot is held PEAK_HOLD_MS, then falls a row every PEAK_FALL_MS;
+// both count in ticks of PEAK_TICK_MS, at most 15 of them
+#define PEAK_TICK_MS	25
+#define PEAK_HOLD_MS	300
+#define PEAK_FALL_MS	100
+// bar smoothing: a bar rises with time constant SMOOTH_ATTACK_MS and falls
+// with SMOOTH_RELEASE_MS (ms, 0 follows at once); or AVERAGE_LOG2, a bar is
+// the RMS of about the last 2**AVERAGE_LOG2 frames. Either costs COLUMNS
+// bytes of RAM.
+//#define SMOOTH_ATTACK_MS	20
+//#define SMOOTH_RELEASE_MS	150
+//#define AVERAGE_LOG2	2
+//#define DEBUG 1
+// FFT input window, WINDOW_HANN, _HAMMING, _BLACKMAN_HARRIS, _KAISER or
+// _FLATTOP of spectrum_tables.h (make tables), the display is corrected
+// for its coherent gain
+//#define WINDOWING	WINDOW_KAISER
+// magnitude() level maps, LEVEL_MAP is used for signals, LEVEL_TONE
+// while the test tone is on
+#define LEVEL_LINEAR	0
+#define LEVEL_TONE	1
+#define LEVEL_LOG	2
+#define LEVEL_DB	3					// DB_FLOOR .. DB_FLOOR+DB_RANGE in 8 rows
+#define LEVEL_MAP	LEVEL_DB
+// dBFS of the lowest row and dB covered by the 8 rows, 0 dBFS = bin magnitude 128
+#define DB_FLOOR	-42
+#define DB_RANGE	40
+// automatic gain: the 10 bit samples are shifted right by 0..3 into the
+// int8 FFT input so the frame peak tracks AGC_TARGET, the envelope rising
+// by 1/2**AGC_ATTACK and falling by 1/2**AGC_RELEASE of the difference per
+// frame; fixed GAIN_SHIFT without AGC. Level maps are calibrated for GAIN_SHIFT.
+// AGC_TARGET is 127/sqrt(2), the largest sample fix_fftr() packs in pairs
+// without halving its input first (PEAK_PACK of fix_fft.c).
+#define AGC
+#define AGC_TARGET	89
+#define AGC_ATTACK	1
+#define AGC_RELEASE	4
+#define GAIN_SHIFT	2
+// running DC estimate in Q(DC_Q), low pass of 2**DC_LOG2 samples time constant
+#define DC_Q		5
+#define DC_LOG2		6
+// Goertzel filters on these tones (Hz) instead of the FFT, see goertzel.c
+//#define GOERTZEL	{ 1000, 1500, 2000, 3000 }
+//#define GOERTZEL_TONES	4				// of GOERTZEL, for the RAM budget
+
+// FFT sizes, Nx = 2**log2N real points for Nx/2 bins, a long press of
+// the mode button steps through LOG2N_MIN..LOG2N_MAX in spectrum mode
+#define LOG2N_MIN	5
+#define LOG2N_MAX	7					// 8 needs more than RAM_SIZE
+#define LOG2N_DEFAULT	6
+#define NX_MAX		(1 << LOG2N_MAX)
+// display columns, the bins are folded onto them; DISPLAY_MODULES of max7219.h
+#define COLUMNS		DISPLAY_COLUMNS
+// HOPs per Nx: new samples per frame are Nx/HOPS, the FFT sees the last Nx
+// of them: 1 no overlap, 2 50%, 4 75% (HOPS spectra per block length); a
+// frame taking longer than a HOP drops samples, the next window is all new
+#define HOPS		1
+// sample rates as the band (Nyquist) in kHz, a long press of the mode
+// button steps through them in scope mode
+#define BANDS_KHZ	{ 2, 4, 8 }
+#define BAND_DEFAULT	1
+#define LONG_PRESS_MS	500
+
+// sample period in SMCLK ticks, Nyquist at khz
+#define SAMPLE_PERIOD(khz)	((SMCLK_HZ/1000/((khz)*2))-1)
+#define SAMPLE_RATE(khz)	((khz)*2000U)
+
+// RAM plan, every buffer is static so the map accounts for all but the stack:
+//  arena[ARENA]	capture ring of the last Nx conditioned samples, and the
+//			FFT frame data[] that acquire() fills from it; the FFT,
+//			magnitude() and columns() then work in data[] in place
+//  dots[COLUMNS]	peak dots, and bars[COLUMNS] for the bar smoothing,
+//			spectrum.c, kept from frame to frame
+//  dbuff, shown		display bitmap and the one last sent to the chain, and
+//  pending, spibuff	the modules left to send and the SPI frame going out,
+//			max7219.c
+// Sizes with 2*Nx > ARENA run in place, without overlap, the frame on top of
+// the ring and the capture held until the next acquire(). The arena plus
+// RAM_OTHER must fit the RAM, RAM_OTHER being
+//  RAM_STATIC	the other statics, counted from their declarations: per
+//		column dbuff, shown, spibuff/8 and dots (and bars), besides
+//		34 bytes of hal_msp430.c, 25 + HOPS of spectrum.c, 9 of
+//		max7219.c and 3 of padding; "make ram" reports them per object.
+//		With GOERTZEL the GOERTZEL_TONES goertzel_t of led_fft.c, 12
+//		bytes each on the MSP430 (14 with FFT_BITS 16)
+//  RAM_STACK	the deepest stack, the sum of the -fstack-usage frames of the
+//		deepest call chain and interrupt that "make ram" prints:
+//		main > fix_fftr > fix_fft_stages > FIX_MPY, about 20 + 26 + 30
+//		+ 8 bytes at -Os, then ADC10_ISR > arrive, about 36 with the
+//		PC, SR and caller saved registers. An estimate, not measured:
+//		replace it with the report of "make ram" on a firmware build
+//  RAM_MARGIN	spare stack, for the libgcc multiply and shift helpers that
+//		-fstack-usage does not see and for changes to the code
+#define ARENA		NX_MAX
+#define RAM_SIZE	512					// MSP430G2553
+#if defined(SMOOTH_RELEASE_MS) || defined(AVERAGE_LOG2)
+#define RAM_BARS	COLUMNS
+#else
+#define RAM_BARS	0
+#endif
+#ifdef GOERTZEL
+#define RAM_GOERTZEL	(GOERTZEL_TONES * (FFT_BITS == 16 ? 14 : 12))
+#else
+#define RAM_GOERTZEL	0
+#endif
+#define RAM_STATIC	(71 + HOPS + 3*COLUMNS + COLUMNS/4 + RAM_BARS + RAM_GOERTZEL)
+#define RAM_STACK	120					// estimate, see above
+#define RAM_MARGIN	32
+#define RAM_OTHER	(RAM_STATIC + RAM_STACK + RAM_MARGIN)
+
+#if LOG2N_MIN < 5 || LOG2N_MAX > 8 || LOG2N_DEFAULT < LOG2N_MIN || LOG2N_DEFAULT > LOG2N_MAX
+#error FFT sizes are 2**5 (COLUMNS) to 2**8 (uint8_t indices) points
+#endif
+#if HOPS & (HOPS - 1)
+#error HOPS must be a power of 2
+#endif
+#if ARENA < NX_MAX
+#error the arena must hold the largest frame
+#endif
+#if ARENA + RAM_OTHER > RAM_SIZE
+#error RAM budget exceeded, lower LOG2N_MAX, ARENA, DISPLAY_MODULES or GOERTZEL_TONES
+#endif
+#if COLUMNS > ARENA / 2
+#error columns() widens the bins to COLUMNS bytes of the frame, raise ARENA
+#endif
+#if PEAK_HOLD_MS / PEAK_TICK_MS > 15 || PEAK_FALL_MS / PEAK_TICK_MS < 1 || PEAK_FALL_MS / PEAK_TICK_MS > 15
+#error PEAK_HOLD_MS and PEAK_FALL_MS are 0..15 and 1..15 ticks of PEAK_TICK_MS
+#endif
+#if defined(SMOOTH_RELEASE_MS) && defined(AVERAGE_LOG2)
+#error SMOOTH_RELEASE_MS and AVERAGE_LOG2 share the bar state, pick one
+#endif
+#if defined(GOERTZEL) && !defined(GOERTZEL_TONES)
+#error GOERTZEL needs GOERTZEL_TONES, the number of its tones
+#endif
+#if defined(SMOOTH_ATTACK_MS) && !defined(SMOOTH_RELEASE_MS)
+#error SMOOTH_ATTACK_MS needs SMOOTH_RELEASE_MS, define it 0 for attack only
+#endif
+
+// (re)start sampling at one sample every period SMCLK ticks for frames of
+// 2**log2n samples, every sample is conditioned as it arrives; returns the
+// frame buffer data[] of acquire() in the arena
+int8_t *capture(uint8_t log2n, uint16_t period);
+// wait for a HOP of new samples, Nx after dropped ones, then the last Nx of
+// them, DC removed, narrowed to int8 by a right shift and, for the spectrum
+// with WINDOWING, windowed into data[]; returns that shift, offset is the DC
+// level around mid scale
+uint8_t acquire(int8_t data[], int16_t *offset, uint8_t window);
+// complex bins -> display level 0..8 in data[] through level map map,
+// bins are 2**exponent larger than the calibrated level (block exponent
+// of fix_fftr() plus gain)
+void magnitude(int8_t data[], const int8_t im[], uint8_t n, uint8_t map, int8_t exponent);
+// n levels of bins -> COLUMNS levels in place, the loudest of each group
+// of bins or a bin over several columns
+void columns(int8_t level[], uint8_t n);
+// n levels smoothed in place and their peak dots held, by the hal_ms()
+// since the last call, so they move alike at every FFT size and band
+void smooth(int8_t level[], uint8_t n);
+// forget the bars and peaks, after a change of FFT size or band
+void smooth_reset(void);
+// bars and peak dots into dbuff, lsb mirrors the spectrum
+void render_bars(const int8_t level[], uint8_t n, uint8_t lsb);
+// pseudo oscilloscope of n samples into dbuff
+void render_scope(int8_t data[], uint16_t n, uint8_t gen_tone, int16_t offset);
+
+#endif // SPECTRUM_H
@@ -0,0 +1,226 @@
+/* spectrum_tables.h - generated by tools/gentables.c, do not edit */
+/*
+  Constant tables of spectrum.c.
+
+  WINDOW_HALF(m) is the FFT input window for Nx = 2**m,
+  LOG2N_MIN <= m <= LOG2N_MAX, 4 <= Nx <= 256, stored as the
+  first half of the symmetric window in Q8, w[Nx-1-i] = w[i],
+  picked by WINDOWING (Kaiser beta 6). The window takes the
+  coherent gain CG (mean of w) off a tone: WINDOW_CG2(m) is
+  CG*CG in Q16, WINDOW_CG_LOG2(m) is -log2(CG) in Q8.
+
+  log2_mant[] is the fraction of log2_q8(), 256*log2(1+f) at the
+  middle of each of the 16 intervals of the mantissa f.
+*/
+
+#ifndef SPECTRUM_TABLES_H
+#define SPECTRUM_TABLES_H
+
+#define WINDOW_HANN	1
+#define WINDOW_HAMMING	2
+#define WINDOW_BLACKMAN_HARRIS	3
+#define WINDOW_KAISER	4
+#define WINDOW_FLATTOP	5
+
+#ifdef WINDOWING
+#if LOG2N_MIN < 2 || LOG2N_MAX > 8
+#error no window table for these FFT sizes, see tools/gentables.c
+#endif
+
+#if WINDOWING == WINDOW_HANN
+static const uint8_t window_half[] = {
+#if LOG2N_MIN <= 2 && LOG2N_MAX >= 2
+	0, 191,
+#endif
+#if LOG2N_MIN <= 3 && LOG2N_MAX >= 3
+	0, 48, 156, 242,
+#endif
+#if LOG2N_MIN <= 4 && LOG2N_MAX >= 4
+	0, 11, 42, 88, 141, 191, 231, 252,
+#endif
+#if LOG2N_MIN <= 5 && LOG2N_MAX >= 5
+	0, 3, 10, 23, 40, 60, 83, 108, 134, 159, 184, 206, 224, 239, 249, 254,
+#endif
+#if LOG2N_MIN <= 6 && LOG2N_MAX >= 6
+	0, 1, 3, 6, 10, 16, 22, 30, 38, 48, 58, 69, 81, 93, 105, 118,
+	131, 143, 156, 168, 180, 191, 202, 212, 221, 229, 236, 242, 247, 251, 254, 255,
+#endif
+#if LOG2N_MIN <= 7 && LOG2N_MAX >= 7
+	0, 0, 1, 1, 2, 4, 6, 8, 10, 12, 15, 18, 22, 25, 29, 34,
+	38, 42, 47, 52, 57, 63, 68, 74, 80, 86, 92, 98, 104, 110, 116, 123,
+	129, 135, 142, 148, 154, 160, 166, 172, 178, 184, 189, 195, 200, 205, 210, 215,
+	219, 224, 228, 231, 235, 238, 241, 244, 246, 248, 250, 252, 253, 254, 255, 255,
+#endif
+#if LOG2N_MIN <= 8 && LOG2N_MAX >= 8
+	0, 0, 0, 0, 1, 1, 1, 2, 2, 3, 4, 5, 6, 6, 8, 9,
+	10, 11, 12, 14, 15, 17, 18, 20, 22, 23, 25, 27, 29, 31, 33, 35,
+	38, 40, 42, 45, 47, 49, 52, 54, 57, 60, 62, 65, 68, 71, 73, 76,
+	79, 82, 85, 88, 91, 94, 97, 100, 103, 106, 109, 113, 116, 119, 122, 125,
+	128, 131, 135, 138, 141, 144, 147, 150, 153, 156, 159, 162, 165, 168, 171, 174,
+	177, 180, 183, 186, 189, 191, 194, 197, 199, 202, 204, 207, 209, 212, 214, 216,
+	218, 221, 223, 225, 227, 229, 231, 232, 234, 236, 238, 239, 241, 242, 243, 245,
+	246, 247, 248, 249, 250, 251, 252, 252, 253, 253, 254, 254, 255, 255, 255, 255,
+#endif
+};
+static const uint16_t window_cg2[] = { 9120, 12432, 14280, 15252, 15750, 15986, 16123 };
+static const int16_t window_cg_log2[] = { 364, 307, 281, 269, 263, 261, 259 };
+#elif WINDOWING == WINDOW_HAMMING
+static const uint8_t window_half[] = {
+#if LOG2N_MIN <= 2 && LOG2N_MAX >= 2
+	20, 196,
+#endif
+#if LOG2N_MIN <= 3 && LOG2N_MAX >= 3
+	20, 65, 164, 243,
+#endif
+#if LOG2N_MIN <= 4 && LOG2N_MAX >= 4
+	20, 31, 59, 101, 150, 196, 233, 252,
+#endif
+#if LOG2N_MIN <= 5 && LOG2N_MAX >= 5
+	20, 23, 30, 41, 57, 76, 97, 120, 144, 167, 189, 210, 227, 240, 250, 254,
+#endif
+#if LOG2N_MIN <= 6 && LOG2N_MAX >= 6
+	20, 21, 23, 26, 30, 35, 41, 48, 56, 65, 74, 84, 95, 106, 117, 129,
+	141, 152, 164, 175, 186, 196, 206, 215, 224, 231, 238, 243, 248, 251, 254, 255,
+#endif
+#if LOG2N_MIN <= 7 && LOG2N_MAX >= 7
+	20, 21, 21, 22, 23, 24, 26, 27, 29, 32, 34, 37, 40, 44, 47, 51,
+	55, 59, 64, 69, 73, 78, 83, 88, 94, 99, 105, 110, 116, 122, 128, 133,
+	139, 145, 151, 156, 162, 168, 173, 179, 184, 190, 195, 200, 205, 209, 214, 218,
+	222, 226, 230, 233, 237, 240, 242, 245, 247, 249, 251, 252, 253, 254, 255, 255,
+#endif
+#if LOG2N_MIN <= 8 && LOG2N_MAX >= 8
+	20, 20, 21, 21, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 28,
+	29, 31, 32, 33, 34, 36, 37, 39, 40, 42, 44, 45, 47, 49, 51, 53,
+	55, 57, 59, 61, 64, 66, 68, 71, 73, 75, 78, 80, 83, 85, 88, 91,
+	93, 96, 99, 101, 104, 107, 110, 113, 115, 118, 121, 124, 127, 130, 133, 136,
+	138, 141, 144, 147, 150, 153, 156, 159, 161, 164, 167, 170, 173, 175, 178, 181,
+	183, 186, 189, 191, 194, 196, 199, 201, 204, 206, 208, 211, 213, 215, 217, 219,
+	221, 223, 225, 227, 229, 231, 233, 234, 236, 237, 239, 240, 242, 243, 244, 245,
+	247, 248, 249, 249, 250, 251, 252, 252, 253, 253, 254, 254, 255, 255, 255, 255,
+#endif
+};
+static const uint16_t window_cg2[] = { 11664, 15129, 16965, 17973, 18471, 18705, 18825 };
+static const int16_t window_cg_log2[] = { 319, 271, 250, 239, 234, 232, 230 };
+#elif WINDOWING == WINDOW_BLACKMAN_HARRIS
+static const uint8_t window_half[] = {
+#if LOG2N_MIN <= 2 && LOG2N_MAX >= 2
+	0, 133,
+#endif
+#if LOG2N_MIN <= 3 && LOG2N_MAX >= 3
+	0, 9, 85, 227,
+#endif
+#if LOG2N_MIN <= 4 && LOG2N_MAX >= 4
+	0, 1, 7, 26, 68, 133, 202, 249,
+#endif
+#if LOG2N_MIN <= 5 && LOG2N_MAX >= 5
+	0, 0, 1, 3, 6, 13, 24, 40, 61, 89, 121, 156, 190, 220, 242, 253,
+#endif
+#if LOG2N_MIN <= 6 && LOG2N_MAX >= 6
+	0, 0, 0, 0, 1, 1, 2, 4, 6, 9, 12, 17, 22, 29, 37, 47,
+	58, 71, 85, 100, 116, 133, 150, 167, 184, 199, 214, 227, 238, 246, 252, 255,
+#endif
+#if LOG2N_MIN <= 7 && LOG2N_MAX >= 7
+	0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3, 4, 5,
+	6, 7, 8, 10, 12, 14, 16, 19, 22, 25, 28, 32, 37, 41, 46, 51,
+	57, 63, 69, 76, 83, 90, 98, 105, 113, 122, 130, 138, 147, 155, 164, 172,
+	180, 189, 196, 204, 211, 218, 224, 230, 235, 240, 244, 248, 251, 253, 254, 255,
+#endif
+#if LOG2N_MIN <= 8 && LOG2N_MAX >= 8
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+	1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 4, 4, 5, 5,
+	6, 6, 7, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 19, 20,
+	21, 23, 25, 26, 28, 30, 32, 34, 36, 38, 41, 43, 45, 48, 51, 53,
+	56, 59, 62, 65, 68, 72, 75, 78, 82, 85, 89, 93, 96, 100, 104, 108,
+	112, 116, 120, 124, 129, 133, 137, 141, 145, 150, 154, 158, 162, 167, 171, 175,
+	179, 183, 187, 191, 195, 199, 202, 206, 210, 213, 217, 220, 223, 226, 229, 232,
+	234, 237, 239, 241, 243, 245, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255,
+#endif
+};
+static const uint16_t window_cg2[] = { 4422, 6440, 7353, 7865, 8111, 8236, 8302 };
+static const int16_t window_cg_log2[] = { 498, 428, 404, 392, 386, 383, 382 };
+#elif WINDOWING == WINDOW_KAISER
+static const uint8_t window_half[] = {
+#if LOG2N_MIN <= 2 && LOG2N_MAX >= 2
+	4, 187,
+#endif
+#if LOG2N_MIN <= 3 && LOG2N_MAX >= 3
+	4, 51, 151, 241,
+#endif
+#if LOG2N_MIN <= 4 && LOG2N_MAX >= 4
+	4, 18, 46, 86, 136, 187, 228, 252,
+#endif
+#if LOG2N_MIN <= 5 && LOG2N_MAX >= 5
+	4, 9, 18, 29, 44, 61, 82, 105, 129, 154, 179, 202, 221, 237, 249, 254,
+#endif
+#if LOG2N_MIN <= 6 && LOG2N_MAX >= 6
+	4, 6, 9, 13, 17, 23, 29, 35, 43, 51, 60, 70, 80, 91, 102, 114,
+	126, 138, 151, 163, 175, 187, 198, 208, 218, 227, 234, 241, 247, 251, 253, 255,
+#endif
+#if LOG2N_MIN <= 7 && LOG2N_MAX >= 7
+	4, 5, 6, 8, 9, 11, 13, 15, 17, 20, 22, 25, 28, 31, 35, 38,
+	42, 46, 50, 55, 59, 64, 69, 74, 79, 84, 90, 95, 101, 107, 113, 119,
+	125, 131, 137, 143, 149, 155, 161, 167, 173, 179, 185, 190, 196, 201, 206, 211,
+	216, 221, 225, 229, 233, 237, 240, 243, 245, 248, 250, 252, 253, 254, 255, 255,
+#endif
+#if LOG2N_MIN <= 8 && LOG2N_MAX >= 8
+	4, 4, 5, 6, 6, 7, 8, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+	17, 18, 20, 21, 22, 24, 25, 27, 28, 30, 31, 33, 35, 36, 38, 40,
+	42, 44, 46, 48, 50, 52, 54, 57, 59, 61, 64, 66, 68, 71, 73, 76,
+	78, 81, 84, 86, 89, 92, 95, 98, 100, 103, 106, 109, 112, 115, 118, 121,
+	124, 127, 130, 133, 136, 139, 142, 145, 148, 151, 154, 157, 160, 163, 166, 169,
+	172, 175, 178, 181, 184, 187, 189, 192, 195, 198, 200, 203, 205, 208, 210, 213,
+	215, 218, 220, 222, 224, 226, 228, 230, 232, 234, 236, 237, 239, 241, 242, 244,
+	245, 246, 247, 248, 249, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+#endif
+};
+static const uint16_t window_cg2[] = { 9120, 12488, 14310, 15268, 15774, 16014, 16125 };
+static const int16_t window_cg_log2[] = { 364, 306, 281, 269, 263, 260, 259 };
+#elif WINDOWING == WINDOW_FLATTOP
+static const uint8_t window_half[] = {
+#if LOG2N_MIN <= 2 && LOG2N_MAX >= 2
+	0, 51,
+#endif
+#if LOG2N_MIN <= 3 && LOG2N_MAX >= 3
+	0, 0, 3, 199,
+#endif
+#if LOG2N_MIN <= 4 && LOG2N_MAX >= 4
+	0, 0, 0, 0, 0, 51, 155, 242,
+#endif
+#if LOG2N_MIN <= 5 && LOG2N_MAX >= 5
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 37, 81, 133, 186, 228, 252,
+#endif
+#if LOG2N_MIN <= 6 && LOG2N_MAX >= 6
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 3, 15, 31, 51, 73, 97, 123, 150, 175, 199, 220, 237, 248, 254,
+#endif
+#if LOG2N_MIN <= 7 && LOG2N_MAX >= 7
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 1, 7, 13, 20, 29, 37, 47, 58, 69, 80, 93, 105,
+	118, 131, 144, 157, 170, 182, 194, 205, 216, 225, 233, 240, 246, 250, 253, 255,
+#endif
+#if LOG2N_MIN <= 8 && LOG2N_MAX >= 8
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 6, 9, 12, 16, 19, 23,
+	27, 32, 36, 41, 46, 51, 56, 61, 67, 72, 78, 84, 90, 97, 103, 109,
+	116, 122, 129, 135, 142, 148, 155, 161, 168, 174, 180, 186, 192, 198, 203, 208,
+	213, 218, 223, 227, 231, 235, 239, 242, 245, 247, 249, 251, 253, 254, 255, 255,
+#endif
+};
+static const uint16_t window_cg2[] = { 650, 2550, 3136, 3328, 3437, 3485, 3518 };
+static const int16_t window_cg_log2[] = { 852, 599, 561, 550, 544, 542, 540 };
+#else
+#error unknown WINDOWING
+#endif
+
+#define WINDOW_HALF(m)	(window_half + (1 << ((m) - 1)) - (1 << (LOG2N_MIN - 1)))
+#define WINDOW_CG2(m)	window_cg2[(m) - 2]
+#define WINDOW_CG_LOG2(m)	window_cg_log2[(m) - 2]
+#endif // WINDOWING
+
+static const uint8_t log2_mant[16] = { 11, 33, 54, 73, 92, 109, 126, 142, 157, 172, 186, 200, 213, 226, 238, 250 };
+
+#endif /* SPECTRUM_TABLES_H */
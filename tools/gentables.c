@@ -0,0 +1,300 @@
+/******************************************************************************
+gentables.c - host generator for the constant tables in src/
+
+	gentables fix_fft > src/fix_fft_tables.h
+	gentables spectrum [KAISER_BETA] > src/spectrum_tables.h
+
+Run through "make tables", the generated files are committed so the MSP430
+build needs no host compiler. Every table is emitted for all the sizes a
+build may select, under #if guards, so changing LOG2_N_WAVE, the FFT sizes
+or WINDOWING needs no new run.
+
+******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WAVE_LOG2_MIN	2		// LOG2_N_WAVE range of fix_fft.h
+#define WAVE8_LOG2_MAX	8		// fix_fft.c
+#define WAVE16_LOG2_MAX	10		// fix_fft.init16_t.c
+#define BITREV_LOG2_MAX	WAVE16_LOG2_MAX
+#define WINDOW_LOG2_MIN	2		// Nx of spectrum.h, uint8_t indices
+#define WINDOW_LOG2_MAX	8
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static unsigned reverse(unsigned i, int m) {
+	unsigned r = 0;
+	while (m--) {
+		r = (r << 1) | (i & 1);
+		i >>= 1;
+	}
+	return r;
+}
+
+/*
+  sin(2*pi*j/n) for 0 <= j < 3n/4 in the scale of the original tables:
+  truncated 128*sin clipped to 127 for int8, truncated 32767*sin for
+  int16. The quarter wave 0 <= j <= n/4 of FFT_QUARTER_WAVE is the
+  start of it, the rest follows that exactly by symmetry.
+*/
+static void sinewave(int bits, int log2_max) {
+	int m, n, j, col;
+
+	printf("#%sif FFT_BITS == %d\n", bits == 16 ? "" : "el", bits);
+	for (m = WAVE_LOG2_MIN; m <= log2_max; ++m) {
+		n = 1 << m;
+		printf("#%sif LOG2_N_WAVE == %d\n", m == WAVE_LOG2_MIN ? "" : "el", m);
+		printf("const int%d_t Sinewave[SINEWAVE_LEN] = {", bits);
+		for (j = col = 0; j < n - n / 4; ++j) {
+			double s = sin(2 * M_PI * j / n);
+			long v = bits == 16 ? (long)(32767 * s) : (long)(128 * s);
+			if (v > 127 && bits == 8)
+				v = 127;
+			if (j == n / 4 + 1) {
+				printf("\n#ifndef FFT_QUARTER_WAVE");
+				col = 0;
+			}
+			if (!(col++ & 7))
+				printf("\n");
+			printf(bits == 16 ? "%7ld," : "%5ld,", v);
+		}
+		printf("\n#endif\n};\n");
+	}
+	printf("#else\n#error no Sinewave[] for this LOG2_N_WAVE, see tools/gentables.c\n#endif\n");
+}
+
+/*
+  swap pairs (i, rev(i)) with i < rev(i) of every size 2**m,
+  concatenated in order of m so a build can cut the array at any m
+*/
+static void bitrev(void) {
+	unsigned start[BITREV_LOG2_MAX + 2], count = 0, i, r, col;
+	int m;
+
+	for (m = 0; m <= BITREV_LOG2_MAX; ++m) {
+		start[m] = count;
+		for (i = 0; i < (1u << m); ++i)
+			if (i < reverse(i, m))
+				++count;
+	}
+	start[m] = count;
+
+	printf("#ifndef BITREV_MAX_M\n"
+		"#define BITREV_MAX_M LOG2_N_WAVE\n"
+		"#endif\n\n"
+		"#if BITREV_MAX_M > 8\n"
+		"typedef uint16_t bitrev_t;\n"
+		"#else\n"
+		"typedef uint8_t bitrev_t;\n"
+		"#endif\n\n");
+
+	printf("static const uint16_t bitrev_start[%d] = {", BITREV_LOG2_MAX + 2);
+	for (m = 0; m <= BITREV_LOG2_MAX + 1; ++m)
+		printf("%s%u", m ? ", " : " ", start[m]);
+	printf(" };\n\nstatic const bitrev_t bitrev_pairs[] = {\n");
+
+	for (m = 2; m <= BITREV_LOG2_MAX; ++m) {
+		printf("#if BITREV_MAX_M >= %d\n", m);
+		col = 0;
+		for (i = 0; i < (1u << m); ++i) {
+			r = reverse(i, m);
+			if (i >= r)
+				continue;
+			printf(" %u, %u,", i, r);
+			if (++col == 8) {
+				putchar('\n');
+				col = 0;
+			}
+		}
+		if (col)
+			putchar('\n');
+		printf("#endif\n");
+	}
+	printf(" 0\t/* keeps the array non-empty for BITREV_MAX_M < 2 */\n"
+		"};\n");
+}
+
+static void fix_fft_tables(void) {
+	printf("/* fix_fft_tables.h - generated by tools/gentables.c, do not edit */\n"
+		"/*\n"
+		"  Constant tables of fix_fft.c (FFT_BITS 8) and\n"
+		"  fix_fft.init16_t.c (FFT_BITS 16), included by them only.\n"
+		"\n"
+		"  Sinewave[] is sin(2*pi*j/N_WAVE) for 0 <= j < 3*N_WAVE/4,\n"
+		"  the twiddle factors, for LOG2_N_WAVE %d..%d (int8) or %d..%d\n"
+		"  (int16); 0 <= j <= N_WAVE/4 only with FFT_QUARTER_WAVE.\n"
+		"\n"
+		"  bitrev_pairs[] is the bit-reversal permutation of fix_fft()\n"
+		"  as swap pairs, only the indices that actually move. The pairs\n"
+		"  of size 2**m are bitrev_pairs[2*bitrev_start[m] ..\n"
+		"  2*bitrev_start[m+1]-1]. Tables are kept up to BITREV_MAX_M\n"
+		"  (default LOG2_N_WAVE), lower it to save flash when only small\n"
+		"  sizes are used.\n"
+		"*/\n\n"
+		"#ifndef FIX_FFT_TABLES_H\n"
+		"#define FIX_FFT_TABLES_H\n\n",
+		WAVE_LOG2_MIN, WAVE8_LOG2_MAX, WAVE_LOG2_MIN, WAVE16_LOG2_MAX);
+	sinewave(16, WAVE16_LOG2_MAX);
+	sinewave(8, WAVE8_LOG2_MAX);
+	printf("#endif\n\n");
+	bitrev();
+	printf("\n#endif /* FIX_FFT_TABLES_H */\n");
+}
+
+enum { HANN = 1, HAMMING, BLACKMAN_HARRIS, KAISER, FLATTOP, WINDOWS };
+
+static const char *window_name[WINDOWS] = {
+	NULL, "HANN", "HAMMING", "BLACKMAN_HARRIS", "KAISER", "FLATTOP"
+};
+
+// zeroth order modified Bessel function of the first kind
+static double bessel_i0(double x) {
+	double t = 1, s = 1;
+	int k;
+	for (k = 1; t > 1e-12 * s; ++k) {
+		t *= (x / (2 * k)) * (x / (2 * k));
+		s += t;
+	}
+	return s;
+}
+
+// cosine sum a[0] - a[1] cos(x) + a[2] cos(2x) - ...
+static double cosine_sum(const double a[], int terms, double x) {
+	double w = 0;
+	int k;
+	for (k = 0; k < terms; ++k)
+		w += (k & 1 ? -a[k] : a[k]) * cos(k * x);
+	return w;
+}
+
+// point i of the symmetric window of n points
+static double window(int kind, int i, int n, double beta) {
+	static const double hann[] = { 0.5, 0.5 };
+	static const double hamming[] = { 0.54, 0.46 };
+	static const double blackman_harris[] = { 0.35875, 0.48829, 0.14128, 0.01168 };
+	static const double flattop[] = { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 };
+	double x = 2 * M_PI * i / (n - 1), r;
+
+	switch (kind) {
+		case HANN:
+			return cosine_sum(hann, 2, x);
+		case HAMMING:
+			return cosine_sum(hamming, 2, x);
+		case BLACKMAN_HARRIS:
+			return cosine_sum(blackman_harris, 4, x);
+		case KAISER:
+			r = 2.0 * i / (n - 1) - 1;
+			return bessel_i0(beta * sqrt(1 - r * r)) / bessel_i0(beta);
+		default:
+			return cosine_sum(flattop, 5, x);
+	}
+}
+
+/*
+  first half of every window for every Nx of spectrum.h in Q8, w*255
+  rounded (applied as (w*s) >> 8), with the coherent gain of the
+  quantized window; the sizes are concatenated in order so a build
+  keeps just LOG2N_MIN..LOG2N_MAX
+*/
+static void windows(double beta) {
+	long cg2[WINDOW_LOG2_MAX + 1], cg_log2[WINDOW_LOG2_MAX + 1];
+	int kind, m, n, i, col;
+
+	for (kind = 1; kind < WINDOWS; ++kind)
+		printf("#define WINDOW_%s\t%d\n", window_name[kind], kind);
+	printf("\n#ifdef WINDOWING\n"
+		"#if LOG2N_MIN < %d || LOG2N_MAX > %d\n"
+		"#error no window table for these FFT sizes, see tools/gentables.c\n"
+		"#endif\n\n", WINDOW_LOG2_MIN, WINDOW_LOG2_MAX);
+
+	for (kind = 1; kind < WINDOWS; ++kind) {
+		printf("%s WINDOWING == WINDOW_%s\n", kind == 1 ? "#if" : "#elif", window_name[kind]);
+		printf("static const uint8_t window_half[] = {\n");
+		for (m = WINDOW_LOG2_MIN; m <= WINDOW_LOG2_MAX; ++m) {
+			long q, sum = 0;
+			double cg;
+
+			n = 1 << m;
+			printf("#if LOG2N_MIN <= %d && LOG2N_MAX >= %d", m, m);
+			col = 0;
+			for (i = 0; i < n / 2; ++i) {
+				q = lrint(255 * window(kind, i, n, beta));
+				q = q < 0 ? 0 : q;
+				sum += 2 * q;
+				if (col == 0)
+					printf("\n");
+				printf("%s%ld,", col ? " " : "\t", q);
+				if (++col == 16)
+					col = 0;
+			}
+			printf("\n#endif\n");
+			cg = sum / (256.0 * n);
+			cg2[m] = lrint(65536 * cg * cg);
+			cg_log2[m] = lrint(-256 * log2(cg));
+		}
+		printf("};\nstatic const uint16_t window_cg2[] = {");
+		for (m = WINDOW_LOG2_MIN; m <= WINDOW_LOG2_MAX; ++m)
+			printf("%s%ld", m == WINDOW_LOG2_MIN ? " " : ", ", cg2[m]);
+		printf(" };\nstatic const int16_t window_cg_log2[] = {");
+		for (m = WINDOW_LOG2_MIN; m <= WINDOW_LOG2_MAX; ++m)
+			printf("%s%ld", m == WINDOW_LOG2_MIN ? " " : ", ", cg_log2[m]);
+		printf(" };\n");
+	}
+	printf("#else\n#error unknown WINDOWING\n#endif\n\n"
+		"#define WINDOW_HALF(m)\t(window_half + (1 << ((m) - 1)) - (1 << (LOG2N_MIN - 1)))\n"
+		"#define WINDOW_CG2(m)\twindow_cg2[(m) - %d]\n"
+		"#define WINDOW_CG_LOG2(m)\twindow_cg_log2[(m) - %d]\n"
+		"#endif // WINDOWING\n", WINDOW_LOG2_MIN, WINDOW_LOG2_MIN);
+}
+
+// 256*log2(1 + (i+0.5)/16), the middle of each mantissa interval
+static void log2_mant(void) {
+	int i;
+
+	printf("static const uint8_t log2_mant[16] = {");
+	for (i = 0; i < 16; ++i)
+		printf("%s%ld", i ? ", " : " ", lrint(256 * log2(1 + (i + 0.5) / 16)));
+	printf(" };\n");
+}
+
+static void spectrum_tables(double beta) {
+	printf("/* spectrum_tables.h - generated by tools/gentables.c, do not edit */\n"
+		"/*\n"
+		"  Constant tables of spectrum.c.\n"
+		"\n"
+		"  WINDOW_HALF(m) is the FFT input window for Nx = 2**m,\n"
+		"  LOG2N_MIN <= m <= LOG2N_MAX, %d <= Nx <= %d, stored as the\n"
+		"  first half of the symmetric window in Q8, w[Nx-1-i] = w[i],\n"
+		"  picked by WINDOWING (Kaiser beta %g). The window takes the\n"
+		"  coherent gain CG (mean of w) off a tone: WINDOW_CG2(m) is\n"
+		"  CG*CG in Q16, WINDOW_CG_LOG2(m) is -log2(CG) in Q8.\n"
+		"\n"
+		"  log2_mant[] is the fraction of log2_q8(), 256*log2(1+f) at the\n"
+		"  middle of each of the 16 intervals of the mantissa f.\n"
+		"*/\n\n"
+		"#ifndef SPECTRUM_TABLES_H\n"
+		"#define SPECTRUM_TABLES_H\n\n",
+		1 << WINDOW_LOG2_MIN, 1 << WINDOW_LOG2_MAX, beta);
+	windows(beta);
+	printf("\n");
+	log2_mant();
+	printf("\n#endif /* SPECTRUM_TABLES_H */\n");
+}
+
+int main(int argc, char *argv[]) {
+	if (argc == 2 && !strcmp(argv[1], "fix_fft")) {
+		fix_fft_tables();
+		return 0;
+	}
+	if ((argc == 2 || argc == 3) && !strcmp(argv[1], "spectrum")) {
+		spectrum_tables(argc == 3 ? atof(argv[2]) : 6.0);
+		return 0;
+	}
+	fprintf(stderr, "usage: %s fix_fft | spectrum [KAISER_BETA]\n", argv[0]);
+	return 1;
+}
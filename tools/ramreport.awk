@@ -0,0 +1,150 @@
+#!/usr/bin/awk -f
+#
+# ramreport.awk - RAM use per pipeline stage from the GNU ld map and the
+# GCC -fstack-usage files of the firmware build, see "make ram"
+#
+#	awk -v ram=512 -f tools/ramreport.awk build/main.map build/*.su
+#
+# Static RAM is what the map places into .data, .bss and .noinit, summed
+# per object file. The stack column is the largest single frame of the
+# object's functions. The deepest stack is the largest sum of frames along
+# the call chains below, plus the largest interrupt chain on top (they do
+# not nest); it has to fit what is left, see RAM_STACK in src/spectrum.h.
+# The chains follow led_fft.c by hand, a new call of main needs its own.
+# Functions inlined into their caller have no frame of their own, libgcc
+# helpers (software multiply, shifts) none in the .su files.
+
+BEGIN {
+	stage["led_fft"] = "main loop"
+	stage["hal_msp430"] = "capture, SPI, buttons"
+	stage["spectrum"] = "condition, levels, render"
+	stage["fix_fft"] = "FFT"
+	stage["fix_fft.init16_t"] = "FFT"
+	stage["goertzel"] = "Goertzel"
+	stage["max7219"] = "display"
+
+	# every call of main, down to its deepest callee
+	chains = split("main>hal_init>SPI_Init main>Init_MAX7219>hal_spi_write " \
+		"main>update_display>hal_spi_stream main>capture>hal_capture_start " \
+		"main>acquire>agc main>acquire>hal_capture_wait main>acquire>hal_saturation>hal_busy " \
+		"main>fix_fftr>fix_fft_stages>FIX_MPY main>fix_fft>fix_fft_stages>FIX_MPY " \
+		"main>magnitude>log2_q8 main>columns main>smooth>share main>smooth_reset>hal_ms " \
+		"main>render_bars>transpose main>render_scope>transpose " \
+		"main>goertzel_init>fix_sin main>goertzel_reset main>goertzel_update " \
+		"main>goertzel_spectrum>clip8 main>hal_switches main>hal_wait_release " \
+		"main>hal_adc_reference main>hal_tone main>hal_tone_output", chain, " ")
+	isrs = split("ADC10_ISR>arrive USCIAB0TX_ISR>next_frame>reverse Timer0_A1_iSR", isr, " ")
+}
+
+# sum of the frames of a chain of functions
+function depth(c,	n, f, i, d) {
+	n = split(c, f, ">")
+	for (i = 1; i <= n; ++i)
+		d += fn[f[i]]
+	return d
+}
+
+# the deepest of chains c[1..n], in deepest_chain
+function deepest_of(c, n,	i, d, best) {
+	best = -1
+	for (i = 1; i <= n; ++i) {
+		d = depth(c[i])
+		if (d > best) {
+			best = d
+			deepest_chain = c[i]
+		}
+	}
+	return best
+}
+
+# mawk has no hex()
+function hex(s,	i, v) {
+	v = 0
+	for (i = 3; i <= length(s); ++i)
+		v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+	return v
+}
+
+function object(path,	n, p) {
+	n = split(path, p, "/")
+	sub(/\.(o|su)$/, "", p[n])
+	return p[n]
+}
+
+function add(name, size, path,	o) {
+	o = object(path)
+	if (name ~ /^\.data/)
+		data[o] += size
+	else
+		bss[o] += size
+	note(o)
+}
+
+# objects in the order the map and the .su files list them
+function note(o) {
+	if (!(o in seen))
+		order[++objects] = o
+	seen[o] = 1
+}
+
+# -fstack-usage: "file:line:col:function	bytes	qualifiers"
+FILENAME ~ /\.su$/ {
+	o = object(FILENAME)
+	f = $1
+	sub(/.*:/, "", f)
+	if ($2 + 0 > fn[f])
+		fn[f] = $2 + 0
+	if ($2 + 0 > frame[o]) {
+		frame[o] = $2 + 0
+		deepest[o] = $1
+		sub(/.*:/, "", deepest[o])
+	}
+	note(o)
+	next
+}
+
+# the map: output sections start in column 0, input sections are indented
+/^[^ \t]/ {
+	out = $1
+	pending = ""
+	next
+}
+
+out !~ /^\.(data|bss|noinit)$/ {
+	next
+}
+
+# an input section name too long for its column wraps onto the next line
+pending != "" && $1 ~ /^0x/ && NF >= 3 {
+	if ($3 ~ /\.o\)?$/ && hex($2))
+		add(pending, hex($2), $3)
+	pending = ""
+	next
+}
+
+$1 ~ /^(\.(data|bss|noinit)|COMMON)/ {
+	if (NF == 1) {
+		pending = $1
+		next
+	}
+	if (NF >= 4 && $4 ~ /\.o\)?$/ && hex($3))
+		add($1, hex($3), $4)
+}
+
+END {
+	printf "%-18s %-26s %6s %6s %6s  %s\n", "object", "stage", "data", "bss", "frame", "deepest function"
+	for (i = 1; i <= objects; ++i) {
+		o = order[i]
+		printf "%-18s %-26s %6d %6d %6d  %s\n", o, stage[o], data[o], bss[o], frame[o], deepest[o]
+		tdata += data[o]
+		tbss += bss[o]
+	}
+	printf "%-18s %-26s %6d %6d\n", "total", "", tdata, tbss
+	stack = deepest_of(chain, chains)
+	main_chain = deepest_chain
+	stack += deepest_of(isr, isrs)
+	printf "deepest stack %d bytes: %s, then %s\n", stack, main_chain, deepest_chain
+	if (ram)
+		printf "%d of %d bytes static, %d left for the stack, %d spare\n", tdata + tbss, ram,
+			ram - tdata - tbss, ram - tdata - tbss - stack
+}